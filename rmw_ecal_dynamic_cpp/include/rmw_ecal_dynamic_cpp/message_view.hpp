@@ -0,0 +1,111 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+
+#include <rosidl_runtime_c/message_type_support_struct.h>
+#include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
+
+#include "rmw_ecal_dynamic_cpp/visibility.h"
+#include "rmw_ecal_dynamic_cpp/wire_layout.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    template <typename T>
+    class ArrayView
+    {
+      const T *data_;
+      size_t size_;
+
+    public:
+      ArrayView(const T *data, size_t size) : data_{data}, size_{size} {}
+
+      const T *data() const { return data_; }
+      size_t size() const { return size_; }
+      bool empty() const { return size_ == 0; }
+
+      const T *begin() const { return data_; }
+      const T *end() const { return data_ + size_; }
+
+      const T &operator[](size_t index) const { return data_[index]; }
+    };
+
+    //Read-only view over a message serialized by rmw_ecal_dynamic_cpp (e.g. taken with
+    //rmw_take_serialized_message). Fields are located by walking the type introspection,
+    //message itself is never materialized.
+    //Fields are addressed by their name, nested fields are separated by '.' ("header.stamp.sec").
+    //Layout is the one the publisher serialized with, messages written in the other layout are rejected.
+    //Primitive arrays can be viewed in place only if publisher used aligned wire layout
+    //(RMW_ECAL_WIRE_LAYOUT=aligned), otherwise GetArray throws.
+    //Malformed messages and fields not matching requested type are reported by exceptions.
+    class RMW_ECAL_DYNAMIC_CPP_PUBLIC MessageView
+    {
+      using MessageMembers = rosidl_typesupport_introspection_cpp::MessageMembers;
+      using MessageMember = rosidl_typesupport_introspection_cpp::MessageMember;
+
+      const MessageMembers *members_;
+      const char *data_;
+      size_t size_;
+      WireLayout layout_;
+      //first field, behind layout header
+      const char *fields_;
+
+      struct Field
+      {
+        const MessageMember *member;
+        const char *data;
+        //field is part of a memcopyable message, which is copied without any padding
+        bool in_struct;
+      };
+
+      Field FindField(const std::string &path) const;
+      const char *Skip(const MessageMembers *members, const char *data) const;
+      const char *SkipMember(const MessageMember *member, const char *data) const;
+      const char *Align(const char *data, size_t alignment) const;
+      const char *Advance(const char *data, size_t count) const;
+      const char *AdvanceArray(const char *data, size_t count, size_t element_size) const;
+      size_t ReadArraySize(const char **data) const;
+
+      const void *GetSingleData(const std::string &path, size_t element_size) const;
+      const void *GetArrayData(const std::string &path, size_t element_size, size_t element_alignment, size_t *count) const;
+
+    public:
+      MessageView(const rosidl_message_type_support_t *type_support, const void *serialized_data, size_t size, WireLayout layout);
+
+      template <typename T>
+      T Get(const std::string &path) const
+      {
+        T value;
+        std::memcpy(&value, GetSingleData(path, sizeof(T)), sizeof(T));
+        return value;
+      }
+
+      template <typename T>
+      ArrayView<T> GetArray(const std::string &path) const
+      {
+        size_t count;
+        auto data = GetArrayData(path, sizeof(T), alignof(T), &count);
+        return ArrayView<T>{static_cast<const T *>(data), count};
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,32 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //packed:  fields are written back to back (default, compatible with older releases).
+    //aligned: primitive arrays are padded so their elements start at an offset which is
+    //         a multiple of the element alignment, which makes them readable in place.
+    enum class WireLayout
+    {
+      packed,
+      aligned
+    };
+
+  } // namespace rmw
+} // namespace eCAL
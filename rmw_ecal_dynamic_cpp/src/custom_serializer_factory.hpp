@@ -23,6 +23,8 @@
 #include "serialization/serializer_c.hpp"
 #include "serialization/deserializer_cpp.hpp"
 #include "serialization/deserializer_c.hpp"
+#include "serialization/compiled_codec_cpp.hpp"
+#include "serialization/type_info.hpp"
 
 #include "common.hpp"
 
@@ -32,6 +34,10 @@ namespace eCAL
   {
     inline Serializer *CreateSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
     {
+      if (HasCompiledCodec(members))
+      {
+        return new CompiledCppSerializer(members);
+      }
       return new CppSerializer(members);
     }
 
@@ -42,6 +48,10 @@ namespace eCAL
 
     inline Deserializer *CreateDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
     {
+      if (HasCompiledCodec(members))
+      {
+        return new CompiledCppDeserializer(members);
+      }
       return new CppDeserializer(members);
     }
 
@@ -123,6 +133,33 @@ namespace eCAL
         }
         throw std::runtime_error("Unsupported type support.");
       }
+
+      bool GetSerializedSizeBound(const rosidl_message_type_support_t *type_support, size_t *size) const override
+      {
+        auto ts = get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+        if (ts != nullptr)
+        {
+          return GetSerializedSizeBound(TypeInfo::GetLayout(GetCppMembers(ts)), size);
+        }
+
+        ts = get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_c__identifier);
+        if (ts != nullptr)
+        {
+          return GetSerializedSizeBound(TypeInfo::GetLayout(GetCMembers(ts)), size);
+        }
+        throw std::runtime_error("Unsupported type support.");
+      }
+
+    private:
+      static bool GetSerializedSizeBound(const TypeInfo::TypeLayout &layout, size_t *size)
+      {
+        if (!layout.bounded)
+        {
+          return false;
+        }
+        *size = LayoutHeaderSize(GetWireLayout()) + layout.max_serialized_size;
+        return true;
+      }
     };
   } // namespace rmw
 } // namespace eCAL
\ No newline at end of file
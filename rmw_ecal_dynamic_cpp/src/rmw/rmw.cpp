@@ -109,7 +109,7 @@ rmw_ret_t rmw_get_serialized_message_size(const rosidl_message_type_support_t *t
                                           const rosidl_runtime_c__Sequence__bound *message_bounds,
                                           size_t *size)
 {
-  return eCAL::rmw::rmw_get_serialized_message_size(::rmw_get_implementation_identifier(), type_support, message_bounds, size);
+  return eCAL::rmw::rmw_get_serialized_message_size(::rmw_get_implementation_identifier(), eCAL::rmw::CustomSerializerFactory{}, type_support, message_bounds, size);
 }
 
 rmw_ret_t rmw_serialize(const void *ros_message,
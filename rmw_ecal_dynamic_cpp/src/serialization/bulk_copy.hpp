@@ -0,0 +1,184 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+#include <rosidl_runtime_c/string.h>
+
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
+#include "common.hpp"
+
+//libstdc++ stores std::vector<bool> elements in words starting at bit 0 of the first word,
+//so they can be converted 8 at a time. Word access relies on libstdc++ internals, other
+//standard libraries and libstdc++ debug mode (checked iterators) use element wise fallback.
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define RMW_ECAL_BOOL_VECTOR_WORDS
+#endif
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Spreads 8 bits into 8 bytes holding 0 or 1, bit 0 goes to first byte.
+    inline uint64_t ExpandBits(uint8_t bits)
+    {
+      //byte k keeps only bit k, which is then moved to the lowest bit of that byte
+      auto bytes = (bits * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+      return ((bytes + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;
+    }
+
+    //Inverse of ExpandBits, any non-zero byte is treated as true.
+    inline uint8_t PackBytes(uint64_t bytes)
+    {
+      bytes |= (bytes & 0x7f7f7f7f7f7f7f7fULL) + 0x7f7f7f7f7f7f7f7fULL;
+      bytes = (bytes >> 7) & 0x0101010101010101ULL;
+      return static_cast<uint8_t>((bytes * 0x0102040810204080ULL) >> 56);
+    }
+
+#ifdef RMW_ECAL_BOOL_VECTOR_WORDS
+    using BoolVectorWord = std::_Bit_type;
+    static_assert(std::is_unsigned<BoolVectorWord>::value, "Unexpected std::vector<bool> storage.");
+
+    inline const BoolVectorWord *BoolVectorWords(const std::vector<bool> &array)
+    {
+      return array.begin()._M_p;
+    }
+
+    inline BoolVectorWord *BoolVectorWords(std::vector<bool> &array)
+    {
+      return array.begin()._M_p;
+    }
+#endif
+
+    //Writes each element as single byte, dest has to be at least array.size() bytes long.
+    inline void CopyBoolsToBytes(const std::vector<bool> &array, char *dest)
+    {
+      size_t i = 0;
+#ifdef RMW_ECAL_BOOL_VECTOR_WORDS
+      using Word = BoolVectorWord;
+      const Word *words = BoolVectorWords(array);
+      const size_t word_count = array.size() / (8 * sizeof(Word));
+      for (size_t w = 0; w < word_count; w++)
+      {
+        for (size_t b = 0; b < sizeof(Word); b++)
+        {
+          auto bytes = ExpandBits(static_cast<uint8_t>(words[w] >> (8 * b)));
+          std::memcpy(dest + i, &bytes, sizeof(bytes));
+          i += sizeof(bytes);
+        }
+      }
+#endif
+      for (; i < array.size(); i++)
+      {
+        dest[i] = array[i] ? 1 : 0;
+      }
+    }
+
+    //Replaces content of array with size bytes of data, capacity of array is reused.
+    inline void CopyBytesToBools(const char *data, size_t size, std::vector<bool> &array)
+    {
+      array.resize(size);
+      size_t i = 0;
+#ifdef RMW_ECAL_BOOL_VECTOR_WORDS
+      using Word = BoolVectorWord;
+      Word *words = BoolVectorWords(array);
+      const size_t word_count = size / (8 * sizeof(Word));
+      for (size_t w = 0; w < word_count; w++)
+      {
+        Word word = 0;
+        for (size_t b = 0; b < sizeof(Word); b++)
+        {
+          uint64_t bytes;
+          std::memcpy(&bytes, data + i, sizeof(bytes));
+          word |= static_cast<Word>(PackBytes(bytes)) << (8 * b);
+          i += sizeof(bytes);
+        }
+        words[w] = word;
+      }
+#endif
+      for (; i < size; i++)
+      {
+        array[i] = data[i] != 0;
+      }
+    }
+
+    inline const char *StringData(const std::string &str)
+    {
+      return str.data();
+    }
+
+    inline size_t StringSize(const std::string &str)
+    {
+      return str.size();
+    }
+
+    inline const char *StringData(const rosidl_runtime_c__String &str)
+    {
+      return str.data;
+    }
+
+    inline size_t StringSize(const rosidl_runtime_c__String &str)
+    {
+      return str.size;
+    }
+
+    //Appends size prefixed strings. Prefixes and contents are written in single pass into
+    //space which is allocated at once, unless some string is large enough to be referenced.
+    template <typename String>
+    void AppendStrings(const String *strings, size_t count, SerializedSegments &serialized_data)
+    {
+      size_t total_size = count * sizeof(array_size_t);
+      bool referenced = false;
+      for (size_t i = 0; i < count; i++)
+      {
+        total_size += StringSize(strings[i]);
+        referenced = referenced || serialized_data.IsReferenced(StringSize(strings[i]));
+      }
+
+      if (referenced)
+      {
+        for (size_t i = 0; i < count; i++)
+        {
+          array_size_t size = StringSize(strings[i]);
+          serialized_data.Append(reinterpret_cast<const char *>(&size), sizeof(array_size_t));
+          serialized_data.AppendReferenced(StringData(strings[i]), size);
+        }
+        return;
+      }
+
+      auto dest = serialized_data.Extend(total_size);
+      for (size_t i = 0; i < count; i++)
+      {
+        array_size_t size = StringSize(strings[i]);
+        std::memcpy(dest, &size, sizeof(array_size_t));
+        dest += sizeof(array_size_t);
+        if (size > 0)
+        {
+          std::memcpy(dest, StringData(strings[i]), size);
+        }
+        dest += size;
+      }
+    }
+
+  } // namespace rmw
+} // namespace eCAL
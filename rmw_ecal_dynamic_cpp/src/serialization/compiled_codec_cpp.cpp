@@ -0,0 +1,529 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "compiled_codec_cpp.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <cstring>
+
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+
+#include "common.hpp"
+#include "type_info.hpp"
+#include "bulk_copy.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    namespace ts_introspection = rosidl_typesupport_introspection_cpp;
+
+    struct CodecOp;
+
+    struct DeserializationContext
+    {
+      const char *begin;
+      const char *data;
+    };
+
+    using SerializeFunction = void (*)(const CodecOp &op, const char *message, SerializedSegments &serialized_data);
+    using DeserializeFunction = void (*)(const CodecOp &op, DeserializationContext &context, char *message);
+
+    struct CodecOp
+    {
+      SerializeFunction serialize;
+      DeserializeFunction deserialize;
+      //offset of member inside of (flattened) message
+      size_t offset;
+      //size of copied block or of a single array element
+      size_t size;
+      //number of elements of static arrays
+      size_t count;
+      //alignment of array size and array data, always 1 in packed wire layout
+      size_t size_alignment;
+      size_t alignment;
+      const ts_introspection::MessageMember *member;
+      //plan of array elements, nullptr if elements are memcopyable
+      const CodecPlan *element_plan;
+    };
+
+    struct CodecPlan
+    {
+      std::vector<CodecOp> ops;
+      std::vector<std::unique_ptr<CodecPlan>> element_plans;
+    };
+
+    namespace
+    {
+      void SerializePlan(const CodecPlan &plan, const char *message, SerializedSegments &serialized_data)
+      {
+        for (const auto &op : plan.ops)
+        {
+          op.serialize(op, message, serialized_data);
+        }
+      }
+
+      void DeserializePlan(const CodecPlan &plan, DeserializationContext &context, char *message)
+      {
+        for (const auto &op : plan.ops)
+        {
+          op.deserialize(op, context, message);
+        }
+      }
+
+      void Align(size_t alignment, SerializedSegments &serialized_data)
+      {
+        if (alignment > 1)
+        {
+          serialized_data.Append(AlignmentPadding(serialized_data.Size(), alignment), '\0');
+        }
+      }
+
+      void Align(size_t alignment, DeserializationContext &context)
+      {
+        if (alignment > 1)
+        {
+          context.data += AlignmentPadding(context.data - context.begin, alignment);
+        }
+      }
+
+      void WriteArraySize(array_size_t size, SerializedSegments &serialized_data)
+      {
+        serialized_data.Append(reinterpret_cast<const char *>(&size), sizeof(array_size_t));
+      }
+
+      array_size_t ReadArraySize(DeserializationContext &context)
+      {
+        array_size_t size;
+        std::memcpy(&size, context.data, sizeof(array_size_t));
+        context.data += sizeof(array_size_t);
+        return size;
+      }
+
+      void SerializeCopy(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        Align(op.alignment, serialized_data);
+        serialized_data.AppendReferenced(message + op.offset, op.size);
+      }
+
+      void DeserializeCopy(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        Align(op.alignment, context);
+        std::memcpy(message + op.offset, context.data, op.size);
+        context.data += op.size;
+      }
+
+      void SerializeStrings(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        AppendStrings(reinterpret_cast<const std::string *>(message + op.offset), op.count, serialized_data);
+      }
+
+      void DeserializeStrings(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto strings = reinterpret_cast<std::string *>(message + op.offset);
+        for (size_t i = 0; i < op.count; i++)
+        {
+          auto size = ReadArraySize(context);
+          strings[i].assign(context.data, size);
+          context.data += size;
+        }
+      }
+
+      void SerializeStringVector(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        auto &array = *reinterpret_cast<const std::vector<std::string> *>(message + op.offset);
+        WriteArraySize(array.size(), serialized_data);
+        AppendStrings(array.data(), array.size(), serialized_data);
+      }
+
+      void DeserializeStringVector(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto &array = *reinterpret_cast<std::vector<std::string> *>(message + op.offset);
+        array.resize(ReadArraySize(context));
+        for (auto &str : array)
+        {
+          auto size = ReadArraySize(context);
+          str.assign(context.data, size);
+          context.data += size;
+        }
+      }
+
+      template <typename T>
+      void SerializeVector(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        auto &array = *reinterpret_cast<const std::vector<T> *>(message + op.offset);
+        Align(op.size_alignment, serialized_data);
+        WriteArraySize(array.size(), serialized_data);
+        Align(op.alignment, serialized_data);
+        serialized_data.AppendReferenced(reinterpret_cast<const char *>(array.data()), array.size() * sizeof(T));
+      }
+
+      template <typename T>
+      void DeserializeVector(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto &array = *reinterpret_cast<std::vector<T> *>(message + op.offset);
+        Align(op.size_alignment, context);
+        auto size = ReadArraySize(context);
+        array.resize(size);
+        Align(op.alignment, context);
+        if (size > 0)
+        {
+          std::memcpy(array.data(), context.data, size * sizeof(T));
+        }
+        context.data += size * sizeof(T);
+      }
+
+      void SerializeBoolVector(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        auto &array = *reinterpret_cast<const std::vector<bool> *>(message + op.offset);
+        Align(op.size_alignment, serialized_data);
+        WriteArraySize(array.size(), serialized_data);
+        CopyBoolsToBytes(array, serialized_data.Extend(array.size()));
+      }
+
+      void DeserializeBoolVector(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto &array = *reinterpret_cast<std::vector<bool> *>(message + op.offset);
+        Align(op.size_alignment, context);
+        auto size = ReadArraySize(context);
+        CopyBytesToBools(context.data, size, array);
+        context.data += size;
+      }
+
+      void SerializeMessageArray(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        auto data = message + op.offset;
+        for (size_t i = 0; i < op.count; i++)
+        {
+          SerializePlan(*op.element_plan, data, serialized_data);
+          data += op.size;
+        }
+      }
+
+      void DeserializeMessageArray(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto data = message + op.offset;
+        for (size_t i = 0; i < op.count; i++)
+        {
+          DeserializePlan(*op.element_plan, context, data);
+          data += op.size;
+        }
+      }
+
+      void SerializeMessageVector(const CodecOp &op, const char *message, SerializedSegments &serialized_data)
+      {
+        auto member_data = message + op.offset;
+        array_size_t size = op.member->size_function(member_data);
+        WriteArraySize(size, serialized_data);
+        if (size == 0)
+        {
+          return;
+        }
+
+        auto data = static_cast<const char *>(op.member->get_const_function(member_data, 0));
+        if (op.element_plan == nullptr)
+        {
+          serialized_data.AppendReferenced(data, size * op.size);
+          return;
+        }
+        for (array_size_t i = 0; i < size; i++)
+        {
+          SerializePlan(*op.element_plan, data, serialized_data);
+          data += op.size;
+        }
+      }
+
+      void DeserializeMessageVector(const CodecOp &op, DeserializationContext &context, char *message)
+      {
+        auto member_data = message + op.offset;
+        auto size = ReadArraySize(context);
+        op.member->resize_function(member_data, size);
+        if (size == 0)
+        {
+          return;
+        }
+
+        auto data = static_cast<char *>(op.member->get_function(member_data, 0));
+        if (op.element_plan == nullptr)
+        {
+          std::memcpy(data, context.data, size * op.size);
+          context.data += size * op.size;
+          return;
+        }
+        for (array_size_t i = 0; i < size; i++)
+        {
+          DeserializePlan(*op.element_plan, context, data);
+          data += op.size;
+        }
+      }
+
+      CodecOp MakeOp(SerializeFunction serialize, DeserializeFunction deserialize, size_t offset)
+      {
+        return CodecOp{serialize, deserialize, offset, 0, 1, 1, 1, nullptr, nullptr};
+      }
+
+      //Blocks which are contiguous both in message and on the wire are merged into single copy.
+      void AddCopy(CodecPlan &plan, size_t offset, size_t size, size_t alignment)
+      {
+        if (!plan.ops.empty() && alignment == 1)
+        {
+          auto &last = plan.ops.back();
+          if (last.serialize == SerializeCopy && last.offset + last.size == offset)
+          {
+            last.size += size;
+            return;
+          }
+        }
+        auto op = MakeOp(SerializeCopy, DeserializeCopy, offset);
+        op.size = size;
+        op.alignment = alignment;
+        plan.ops.push_back(op);
+      }
+
+      template <typename T>
+      void AddPrimitive(CodecPlan &plan, const ts_introspection::MessageMember *member, size_t offset, WireLayout layout)
+      {
+        const bool aligned = layout == WireLayout::aligned;
+        if (!member->is_array_)
+        {
+          AddCopy(plan, offset, sizeof(T), 1);
+        }
+        else if (member->array_size_ > 0 && !member->is_upper_bound_)
+        {
+          AddCopy(plan, offset, member->array_size_ * sizeof(T), aligned ? ArrayAlignment<T>() : 1);
+        }
+        else
+        {
+          auto op = MakeOp(SerializeVector<T>, DeserializeVector<T>, offset);
+          op.size_alignment = aligned ? ArraySizeAlignment<T>() : 1;
+          op.alignment = aligned ? ArrayAlignment<T>() : 1;
+          plan.ops.push_back(op);
+        }
+      }
+
+      template <>
+      void AddPrimitive<bool>(CodecPlan &plan, const ts_introspection::MessageMember *member, size_t offset, WireLayout layout)
+      {
+        if (member->is_array_ && (member->array_size_ == 0 || member->is_upper_bound_))
+        {
+          auto op = MakeOp(SerializeBoolVector, DeserializeBoolVector, offset);
+          op.size_alignment = layout == WireLayout::aligned ? ArraySizeAlignment<bool>() : 1;
+          plan.ops.push_back(op);
+          return;
+        }
+        AddCopy(plan, offset, member->is_array_ ? member->array_size_ * sizeof(bool) : sizeof(bool), 1);
+      }
+
+      std::unique_ptr<CodecPlan> CompilePlan(const ts_introspection::MessageMembers *members, WireLayout layout);
+
+      void Compile(const ts_introspection::MessageMembers *members, size_t base_offset, WireLayout layout, CodecPlan &plan);
+
+      void AddMessage(CodecPlan &plan, const ts_introspection::MessageMember *member, size_t offset, WireLayout layout)
+      {
+        auto sub_members = GetMembers(member);
+        const bool memcopyable = TypeInfo::IsMemcopyable(sub_members);
+
+        if (!member->is_array_)
+        {
+          //nested messages are flattened into parent plan
+          Compile(sub_members, offset, layout, plan);
+          return;
+        }
+
+        if (member->array_size_ > 0 && !member->is_upper_bound_)
+        {
+          if (memcopyable)
+          {
+            AddCopy(plan, offset, member->array_size_ * sub_members->size_of_, 1);
+            return;
+          }
+          auto op = MakeOp(SerializeMessageArray, DeserializeMessageArray, offset);
+          op.size = sub_members->size_of_;
+          op.count = member->array_size_;
+          plan.element_plans.push_back(CompilePlan(sub_members, layout));
+          op.element_plan = plan.element_plans.back().get();
+          plan.ops.push_back(op);
+          return;
+        }
+
+        auto op = MakeOp(SerializeMessageVector, DeserializeMessageVector, offset);
+        op.size = sub_members->size_of_;
+        op.member = member;
+        if (!memcopyable)
+        {
+          plan.element_plans.push_back(CompilePlan(sub_members, layout));
+          op.element_plan = plan.element_plans.back().get();
+        }
+        plan.ops.push_back(op);
+      }
+
+      void Compile(const ts_introspection::MessageMembers *members, size_t base_offset, WireLayout layout, CodecPlan &plan)
+      {
+        const auto &type_layout = TypeInfo::GetLayout(members);
+        if (type_layout.memcopyable)
+        {
+          AddCopy(plan, base_offset, members->size_of_, 1);
+          return;
+        }
+
+        for (uint32_t i = 0; i < members->member_count_; i++)
+        {
+          const auto member = members->members_ + i;
+          const auto offset = base_offset + member->offset_;
+
+          const auto &pod_run = type_layout.pod_runs[i];
+          if (pod_run.member_count > 1)
+          {
+            AddCopy(plan, offset, pod_run.size, 1);
+            i += pod_run.member_count - 1;
+            continue;
+          }
+
+          switch (member->type_id_)
+          {
+          case ts_introspection::ROS_TYPE_STRING:
+            if (member->is_array_ && (member->array_size_ == 0 || member->is_upper_bound_))
+            {
+              plan.ops.push_back(MakeOp(SerializeStringVector, DeserializeStringVector, offset));
+            }
+            else
+            {
+              auto op = MakeOp(SerializeStrings, DeserializeStrings, offset);
+              op.count = member->is_array_ ? member->array_size_ : 1;
+              plan.ops.push_back(op);
+            }
+            break;
+          case ts_introspection::ROS_TYPE_BOOLEAN:
+            AddPrimitive<bool>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_BYTE:
+            AddPrimitive<uint8_t>(plan, member, offset, layout); //-V1037
+            break;
+          case ts_introspection::ROS_TYPE_CHAR:
+            AddPrimitive<char>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_FLOAT:
+            AddPrimitive<float>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_DOUBLE:
+            AddPrimitive<double>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_LONG_DOUBLE:
+            AddPrimitive<long double>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_INT8:
+            AddPrimitive<int8_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_INT16:
+            AddPrimitive<int16_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_INT32:
+            AddPrimitive<int32_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_INT64:
+            AddPrimitive<int64_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_UINT8:
+            AddPrimitive<uint8_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_UINT16:
+            AddPrimitive<uint16_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_UINT32:
+            AddPrimitive<uint32_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_UINT64:
+            AddPrimitive<uint64_t>(plan, member, offset, layout);
+            break;
+          case ts_introspection::ROS_TYPE_MESSAGE:
+            AddMessage(plan, member, offset, layout);
+            break;
+            //not documented
+          case ts_introspection::ROS_TYPE_WSTRING:
+          case ts_introspection::ROS_TYPE_WCHAR:
+            throw std::logic_error("Wide character/string serialization is unsupported.");
+          }
+        }
+      }
+
+      std::unique_ptr<CodecPlan> CompilePlan(const ts_introspection::MessageMembers *members, WireLayout layout)
+      {
+        std::unique_ptr<CodecPlan> plan{new CodecPlan{}};
+        Compile(members, 0, layout, *plan);
+        return plan;
+      }
+    } // namespace
+
+    CompiledCppSerializer::CompiledCppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout)
+        : plan_(CompilePlan(members, layout)),
+          serialized_size_(LayoutHeaderSize(layout) + TypeInfo::GetLayout(members).serialized_size),
+          layout_(layout)
+    {
+    }
+
+    const std::string CompiledCppSerializer::Serialize(const void *data)
+    {
+      SerializedSegments serialized_data;
+      serialized_data.Reserve(serialized_size_);
+      WriteLayoutHeader(layout_, serialized_data);
+      SerializePlan(*plan_, static_cast<const char *>(data), serialized_data);
+      return std::move(serialized_data.Buffer());
+    }
+
+    void CompiledCppSerializer::SerializeSegments(const void *data, SerializedSegments &serialized_data)
+    {
+      WriteLayoutHeader(layout_, serialized_data);
+      SerializePlan(*plan_, static_cast<const char *>(data), serialized_data);
+    }
+
+    const std::string CompiledCppSerializer::GetMessageStringDescriptor() const
+    {
+      return "";
+    }
+
+    CompiledCppDeserializer::CompiledCppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout)
+        : plan_(CompilePlan(members, layout)),
+          layout_(layout)
+    {
+    }
+
+    void CompiledCppDeserializer::Deserialize(void *message, const void *serialized_data, size_t size)
+    {
+      //alignment is relative to start of buffer, layout header included
+      auto serialized_bytes = SkipLayoutHeader(layout_, serialized_data, size);
+      DeserializationContext context{static_cast<const char *>(serialized_data), serialized_bytes};
+      DeserializePlan(*plan_, context, static_cast<char *>(message));
+    }
+
+    bool HasCompiledCodec(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
+    {
+      //Plans are built from the same layout analysis, so every type it accepts compiles.
+      try
+      {
+        TypeInfo::GetLayout(members);
+        return true;
+      }
+      catch (const std::logic_error &)
+      {
+        return false;
+      }
+    }
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,67 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+
+#include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
+
+#include <rmw_ecal_shared_cpp/serializer.hpp>
+#include <rmw_ecal_shared_cpp/deserializer.hpp>
+
+#include "wire_layout.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    struct CodecPlan;
+
+    //Serializer/deserializer pair which flattens type introspection into a list of
+    //copy operations once, instead of walking it for every message.
+    //Output is byte-identical to CppSerializer/CppDeserializer.
+    class CompiledCppSerializer : public Serializer
+    {
+      std::shared_ptr<const CodecPlan> plan_;
+      size_t serialized_size_;
+      WireLayout layout_;
+
+    public:
+      explicit CompiledCppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout = GetWireLayout());
+
+      virtual const std::string Serialize(const void *data) override;
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data) override;
+      virtual const std::string GetMessageStringDescriptor() const override;
+    };
+
+    class CompiledCppDeserializer : public Deserializer
+    {
+      std::shared_ptr<const CodecPlan> plan_;
+      WireLayout layout_;
+
+    public:
+      explicit CompiledCppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout = GetWireLayout());
+
+      virtual void Deserialize(void *message, const void *serialized_data, size_t size) override;
+    };
+
+    //Returns true for every type a codec plan can be compiled for (all but wide characters/strings).
+    bool HasCompiledCodec(const rosidl_typesupport_introspection_cpp::MessageMembers *members);
+
+  } // namespace rmw
+} // namespace eCAL
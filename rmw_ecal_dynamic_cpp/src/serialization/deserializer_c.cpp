@@ -17,6 +17,7 @@
 #include <string>
 #include <algorithm>
 #include <stdexcept>
+#include <new>
 #include <cstring>
 
 #include <rosidl_typesupport_introspection_c/field_types.h>
@@ -26,6 +27,8 @@
 #include <rosidl_runtime_c/string.h>
 #include <rosidl_runtime_c/string_functions.h>
 
+#include <rcutils/allocator.h>
+
 #include "common.hpp"
 #include "type_info.hpp"
 
@@ -34,6 +37,24 @@ namespace eCAL
   namespace rmw
   {
 
+    void CDeserializer::Align(size_t alignment, const char **serialized_data)
+    {
+      if (layout_ == WireLayout::aligned)
+      {
+        *serialized_data += AlignmentPadding(*serialized_data - buffer_begin_, alignment);
+      }
+    }
+
+    array_size_t CDeserializer::DeserializeArraySize(const char **serialized_data)
+    {
+      //size prefix is unaligned in packed wire layout
+      array_size_t arr_size;
+      std::memcpy(&arr_size, *serialized_data, sizeof(array_size_t));
+      *serialized_data += sizeof(array_size_t);
+
+      return arr_size;
+    }
+
     template <typename T>
     void CDeserializer::DeserializeSingle(char *member, const char **serialized_data)
     {
@@ -44,12 +65,24 @@ namespace eCAL
     template <>
     void CDeserializer::DeserializeSingle<std::string>(char *member, const char **serialized_data)
     {
-      auto size = *reinterpret_cast<const array_size_t *>(*serialized_data);
-      *serialized_data += sizeof(array_size_t);
+      auto size = DeserializeArraySize(serialized_data);
 
       auto sequence = reinterpret_cast<rosidl_runtime_c__String *>(member);
-      rosidl_runtime_c__String__init(sequence);
-      rosidl_runtime_c__String__assignn(sequence, *serialized_data, size);
+      if (sequence->data == nullptr)
+      {
+        rosidl_runtime_c__String__init(sequence);
+      }
+      if (sequence->capacity > size)
+      {
+        //string is big enough, reuse its buffer
+        std::memcpy(sequence->data, *serialized_data, size);
+        sequence->data[size] = '\0';
+        sequence->size = size;
+      }
+      else
+      {
+        rosidl_runtime_c__String__assignn(sequence, *serialized_data, size);
+      }
 
       *serialized_data += size;
     }
@@ -57,6 +90,7 @@ namespace eCAL
     template <typename T>
     void CDeserializer::DeserializeArray(char *member, size_t size, const char **serialized_data)
     {
+      Align(ArrayAlignment<T>(), serialized_data);
       std::copy_n(*serialized_data, sizeof(T) * size, member); //-V575
       *serialized_data += sizeof(T) * size;
     }
@@ -96,15 +130,25 @@ namespace eCAL
     template <typename T>
     void CDeserializer::DeserializeDynamicArray(char *member, const char **serialized_data)
     {
-      auto arr_size = *reinterpret_cast<const array_size_t *>(*serialized_data);
-      *serialized_data += sizeof(array_size_t);
+      Align(ArraySizeAlignment<T>(), serialized_data);
+      auto arr_size = DeserializeArraySize(serialized_data);
 
       auto sequence = reinterpret_cast<rosidl_runtime_c__char__Sequence *>(member);
+      if (sequence->capacity < arr_size)
+      {
+        //sequences are allocated through rcutils allocator by rosidl, grow them the same way
+        auto allocator = rcutils_get_default_allocator();
+        auto data = allocator.reallocate(sequence->data, arr_size * sizeof(T), allocator.state);
+        if (data == nullptr)
+        {
+          throw std::bad_alloc();
+        }
+        sequence->data = static_cast<signed char *>(data);
+        sequence->capacity = arr_size;
+      }
       sequence->size = arr_size;
-      sequence->capacity = arr_size;
       if (arr_size > 0)
       {
-        sequence->data = new signed char[arr_size * sizeof(T)];
         DeserializeArray<T>(reinterpret_cast<char *>(sequence->data), sequence->size, serialized_data);
       }
     }
@@ -112,11 +156,16 @@ namespace eCAL
     template <>
     void CDeserializer::DeserializeDynamicArray<std::string>(char *member, const char **serialized_data)
     {
-      auto arr_size = *reinterpret_cast<const array_size_t *>(*serialized_data);
-      *serialized_data += sizeof(array_size_t);
+      auto arr_size = DeserializeArraySize(serialized_data);
 
       auto sequence = reinterpret_cast<rosidl_runtime_c__String__Sequence *>(member);
-      rosidl_runtime_c__String__Sequence__init(sequence, arr_size);
+      if (sequence->capacity < arr_size)
+      {
+        rosidl_runtime_c__String__Sequence__fini(sequence);
+        rosidl_runtime_c__String__Sequence__init(sequence, arr_size);
+      }
+      //all elements up to capacity are initialized, so shrinking just adjusts size
+      sequence->size = arr_size;
 
       if (arr_size > 0)
       {
@@ -129,19 +178,25 @@ namespace eCAL
                                                                const rosidl_typesupport_introspection_c__MessageMember *member,
                                                                const char **serialized_data)
     {
-      auto arr_size = *reinterpret_cast<const array_size_t *>(*serialized_data);
-      *serialized_data += sizeof(array_size_t);
+      auto arr_size = DeserializeArraySize(serialized_data);
 
       auto sequence = reinterpret_cast<rosidl_runtime_c__char__Sequence *>(message);
+      if (sequence->capacity < arr_size)
+      {
+        //generated resize function finalizes the old sequence and initializes
+        //every new element through the type's own allocator
+        if (!member->resize_function(message, arr_size))
+        {
+          throw std::bad_alloc();
+        }
+      }
       sequence->size = arr_size;
-      sequence->capacity = arr_size;
 
       if (arr_size > 0)
       {
         auto sub_members = GetMembers(member);
 
 	auto data_size = arr_size * sub_members->size_of_;
-        sequence->data = new signed char[data_size ];
         auto data = sequence->data;
 
         if (TypeInfo::IsMemcopyable(sub_members))
@@ -206,7 +261,8 @@ namespace eCAL
                                            const rosidl_typesupport_introspection_c__MessageMembers *members,
                                            char *message)
     {
-      if (TypeInfo::IsMemcopyable(members))
+      const auto &layout = TypeInfo::GetLayout(members);
+      if (layout.memcopyable)
       {
 	auto data_size = members->size_of_;
 	std::memcpy(message, *serialized_data, data_size);
@@ -219,6 +275,16 @@ namespace eCAL
         const auto member = members->members_ + i;
         auto member_data = message + member->offset_;
 
+        //consecutive primitive members without padding in between are copied at once
+        const auto &pod_run = layout.pod_runs[i];
+        if (pod_run.member_count > 1)
+        {
+          std::memcpy(member_data, *serialized_data, pod_run.size);
+          *serialized_data += pod_run.size;
+          i += pod_run.member_count - 1;
+          continue;
+        }
+
         switch (member->type_id_)
         {
         case ::rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
@@ -277,16 +343,19 @@ namespace eCAL
       }
     }
 
-    CDeserializer::CDeserializer(const rosidl_typesupport_introspection_c__MessageMembers *members)
-          : members_(members)
+    CDeserializer::CDeserializer(const rosidl_typesupport_introspection_c__MessageMembers *members, WireLayout layout)
+          : members_(members),
+            layout_(layout)
     {
 	TypeInfo::AnalyzeType(members);
     }
 
-    void CDeserializer::Deserialize(void *message, const void *serialized_data, size_t /* size */)
+    void CDeserializer::Deserialize(void *message, const void *serialized_data, size_t size)
     {
-      auto serialized_bytes = static_cast<const char *>(serialized_data);
+      //alignment is relative to start of buffer, layout header included
+      auto serialized_bytes = SkipLayoutHeader(layout_, serialized_data, size);
       auto message_bytes = static_cast<char *>(message);
+      buffer_begin_ = static_cast<const char *>(serialized_data);
       DeserializeMessage(&serialized_bytes, members_, message_bytes);
     }
 
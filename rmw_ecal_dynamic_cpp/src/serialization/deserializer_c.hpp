@@ -18,6 +18,8 @@
 
 #include <rmw_ecal_shared_cpp/deserializer.hpp>
 
+#include "wire_layout.hpp"
+
 namespace eCAL
 {
   namespace rmw
@@ -26,6 +28,11 @@ namespace eCAL
     class CDeserializer : public Deserializer
     {
       const rosidl_typesupport_introspection_c__MessageMembers *members_;
+      WireLayout layout_;
+      const char *buffer_begin_ = nullptr;
+
+      void Align(size_t alignment, const char **serialized_data);
+      array_size_t DeserializeArraySize(const char **serialized_data);
 
       template <typename T>
       void DeserializeSingle(char *member, const char **serialized_data);
@@ -56,7 +63,7 @@ namespace eCAL
                               char *message);
 
     public:
-      CDeserializer(const rosidl_typesupport_introspection_c__MessageMembers *members);
+      explicit CDeserializer(const rosidl_typesupport_introspection_c__MessageMembers *members, WireLayout layout = GetWireLayout());
 
       virtual void Deserialize(void *message, const void *serialized_data, size_t size) override;
     };
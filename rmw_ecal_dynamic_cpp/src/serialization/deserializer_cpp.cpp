@@ -30,6 +30,7 @@
 
 #include "common.hpp"
 #include "type_info.hpp"
+#include "bulk_copy.hpp"
 
 namespace eCAL
 {
@@ -38,6 +39,14 @@ namespace eCAL
 
     namespace ts_introspection = rosidl_typesupport_introspection_cpp;
 
+    void CppDeserializer::Align(size_t alignment, const char **serialized_data)
+    {
+      if (layout_ == WireLayout::aligned)
+      {
+        *serialized_data += AlignmentPadding(*serialized_data - buffer_begin_, alignment);
+      }
+    }
+
     template <typename T>
     void CppDeserializer::DeserializeSingle(char *member, const char **serialized_data)
     {
@@ -52,16 +61,16 @@ namespace eCAL
 
       auto arr_size = DeserializeArraySize(serialized_data);
 
-      if (arr_size > 0)
-      {
-        str->append(*serialized_data, arr_size);
-        *serialized_data += arr_size;
-      }
+      //assign reuses the capacity of a recycled message instead of reallocating
+      str->assign(*serialized_data, arr_size);
+      *serialized_data += arr_size;
     }
 
     array_size_t CppDeserializer::DeserializeArraySize(const char **serialized_data)
     {
-      auto arr_size = *reinterpret_cast<const array_size_t *>(*serialized_data);
+      //size prefix is unaligned in packed wire layout
+      array_size_t arr_size;
+      std::memcpy(&arr_size, *serialized_data, sizeof(array_size_t));
       *serialized_data += sizeof(array_size_t);
 
       return arr_size;
@@ -70,6 +79,7 @@ namespace eCAL
     template <typename T>
     void CppDeserializer::DeserializeArray(char *member, size_t size, const char **serialized_data)
     {
+      Align(ArrayAlignment<T>(), serialized_data);
       std::copy_n(*serialized_data, sizeof(T) * size, member); //-V575
       *serialized_data += sizeof(T) * size;
     }
@@ -110,6 +120,7 @@ namespace eCAL
     void CppDeserializer::DeserializeDynamicArray(char *member, const char **serialized_data)
     {
       auto array = reinterpret_cast<std::vector<T> *>(member);
+      Align(ArraySizeAlignment<T>(), serialized_data);
       auto arr_size = DeserializeArraySize(serialized_data);
       array->resize(arr_size);
       auto arr_bytes = reinterpret_cast<char *>(array->data());
@@ -120,13 +131,9 @@ namespace eCAL
     void CppDeserializer::DeserializeDynamicArray<bool>(char *member, const char **serialized_data)
     {
       auto array = reinterpret_cast<std::vector<bool> *>(member);
+      Align(ArraySizeAlignment<bool>(), serialized_data);
       auto arr_size = DeserializeArraySize(serialized_data);
-      auto data = reinterpret_cast<const bool *>(*serialized_data);
-      array->reserve(arr_size);
-      for (array_size_t i = 0; i < arr_size; i++)
-      {
-        array->push_back(data[i]);
-      }
+      CopyBytesToBools(*serialized_data, arr_size, *array);
       *serialized_data += arr_size;
     }
 
@@ -137,10 +144,16 @@ namespace eCAL
     {
       auto arr_size = DeserializeArraySize(serialized_data);
       auto sub_members = GetMembers(member);
-      auto vec = reinterpret_cast<std::vector<char> *>(message);
       auto data_size = arr_size * sub_members->size_of_;
-      vec->resize(data_size);
-      auto data = vec->data();
+
+      //resize_function constructs/destroys elements properly and keeps
+      //the vector's capacity, so a recycled message doesn't reallocate
+      member->resize_function(message, arr_size);
+      if (arr_size == 0)
+      {
+        return;
+      }
+      auto data = static_cast<char *>(member->get_function(message, 0));
 
       if (TypeInfo::IsMemcopyable(sub_members))
       {
@@ -207,7 +220,8 @@ namespace eCAL
                                              const ts_introspection::MessageMembers *members,
                                              char *message)
     {
-      if (TypeInfo::IsMemcopyable(members))
+      const auto &layout = TypeInfo::GetLayout(members);
+      if (layout.memcopyable)
       {
 	auto data_size = members->size_of_;
 	std::memcpy(message, *serialized_data, data_size);
@@ -220,6 +234,16 @@ namespace eCAL
         const auto member = members->members_ + i;
         auto member_data = message + member->offset_;
 
+        //consecutive primitive members without padding in between are copied at once
+        const auto &pod_run = layout.pod_runs[i];
+        if (pod_run.member_count > 1)
+        {
+          std::memcpy(member_data, *serialized_data, pod_run.size);
+          *serialized_data += pod_run.size;
+          i += pod_run.member_count - 1;
+          continue;
+        }
+
         switch (member->type_id_)
         {
         case ts_introspection::ROS_TYPE_STRING:
@@ -278,15 +302,18 @@ namespace eCAL
       }
     }
 
-    void CppDeserializer::Deserialize(void *message, const void *serialized_data, size_t /* size */)
+    void CppDeserializer::Deserialize(void *message, const void *serialized_data, size_t size)
     {
-      auto serialized_bytes = static_cast<const char *>(serialized_data);
+      //alignment is relative to start of buffer, layout header included
+      auto serialized_bytes = SkipLayoutHeader(layout_, serialized_data, size);
       auto message_bytes = static_cast<char *>(message);
+      buffer_begin_ = static_cast<const char *>(serialized_data);
       DeserializeMessage(&serialized_bytes, members_, message_bytes);
     }
 
-    CppDeserializer::CppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
-          : members_(members)
+    CppDeserializer::CppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout)
+          : members_(members),
+            layout_(layout)
     {
       TypeInfo::AnalyzeType(members);
     }
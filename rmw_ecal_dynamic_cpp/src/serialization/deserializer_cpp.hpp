@@ -18,6 +18,8 @@
 
 #include <rmw_ecal_shared_cpp/deserializer.hpp>
 
+#include "wire_layout.hpp"
+
 #include "common.hpp"
 
 namespace eCAL
@@ -28,6 +30,10 @@ namespace eCAL
     class CppDeserializer : public Deserializer
     {
       const rosidl_typesupport_introspection_cpp::MessageMembers *members_;
+      WireLayout layout_;
+      const char *buffer_begin_ = nullptr;
+
+      void Align(size_t alignment, const char **serialized_data);
 
       template <typename T>
       void DeserializeSingle(char *member, const char **serialized_data);
@@ -60,7 +66,7 @@ namespace eCAL
                               char *message);
 
     public:
-      CppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members);
+      explicit CppDeserializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout = GetWireLayout());
 
       virtual void Deserialize(void *message, const void *serialized_data, size_t size) override;
     };
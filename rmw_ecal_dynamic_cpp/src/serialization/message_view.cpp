@@ -0,0 +1,326 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_ecal_dynamic_cpp/message_view.hpp"
+
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+#include <rosidl_typesupport_introspection_cpp/identifier.hpp>
+
+#include "common.hpp"
+#include "type_info.hpp"
+#include "wire_layout.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    namespace ts_introspection = rosidl_typesupport_introspection_cpp;
+
+    namespace
+    {
+      struct PrimitiveInfo
+      {
+        size_t size;
+        size_t alignment;
+      };
+
+      template <typename T>
+      bool SetPrimitiveInfo(PrimitiveInfo *info)
+      {
+        *info = PrimitiveInfo{sizeof(T), alignof(T)};
+        return true;
+      }
+
+      //Returns false for strings, nested messages, wide characters/strings and unknown types.
+      bool GetPrimitiveInfo(uint8_t type_id, PrimitiveInfo *info)
+      {
+        switch (type_id)
+        {
+        case ts_introspection::ROS_TYPE_BOOLEAN:
+          return SetPrimitiveInfo<bool>(info);
+        case ts_introspection::ROS_TYPE_BYTE:
+        case ts_introspection::ROS_TYPE_UINT8:
+          return SetPrimitiveInfo<uint8_t>(info);
+        case ts_introspection::ROS_TYPE_CHAR:
+          return SetPrimitiveInfo<char>(info);
+        case ts_introspection::ROS_TYPE_FLOAT:
+          return SetPrimitiveInfo<float>(info);
+        case ts_introspection::ROS_TYPE_DOUBLE:
+          return SetPrimitiveInfo<double>(info);
+        case ts_introspection::ROS_TYPE_LONG_DOUBLE:
+          return SetPrimitiveInfo<long double>(info);
+        case ts_introspection::ROS_TYPE_INT8:
+          return SetPrimitiveInfo<int8_t>(info);
+        case ts_introspection::ROS_TYPE_INT16:
+          return SetPrimitiveInfo<int16_t>(info);
+        case ts_introspection::ROS_TYPE_INT32:
+          return SetPrimitiveInfo<int32_t>(info);
+        case ts_introspection::ROS_TYPE_INT64:
+          return SetPrimitiveInfo<int64_t>(info);
+        case ts_introspection::ROS_TYPE_UINT16:
+          return SetPrimitiveInfo<uint16_t>(info);
+        case ts_introspection::ROS_TYPE_UINT32:
+          return SetPrimitiveInfo<uint32_t>(info);
+        case ts_introspection::ROS_TYPE_UINT64:
+          return SetPrimitiveInfo<uint64_t>(info);
+        default:
+          return false;
+        }
+      }
+
+      //Field can be read as primitive of given size.
+      bool MatchesElementSize(const ts_introspection::MessageMember *member, size_t element_size)
+      {
+        PrimitiveInfo info;
+        return GetPrimitiveInfo(member->type_id_, &info) && info.size == element_size;
+      }
+
+      bool IsStaticArray(const ts_introspection::MessageMember *member)
+      {
+        return member->array_size_ > 0 && !member->is_upper_bound_;
+      }
+    } // namespace
+
+    MessageView::MessageView(const rosidl_message_type_support_t *type_support, const void *serialized_data, size_t size, WireLayout layout)
+        : data_{static_cast<const char *>(serialized_data)},
+          size_{size},
+          layout_{layout}
+    {
+      auto ts = get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+      if (ts == nullptr)
+      {
+        throw std::runtime_error("Unsupported type support.");
+      }
+      members_ = GetCppMembers(ts);
+      TypeInfo::AnalyzeType(members_);
+      //rejects messages of publishers with other layout, fields start after layout header
+      fields_ = SkipLayoutHeader(layout_, data_, size_);
+    }
+
+    const char *MessageView::Advance(const char *data, size_t count) const
+    {
+      //compared against remaining size, so neither pointer nor size arithmetic can overflow
+      if (count > static_cast<size_t>(data_ + size_ - data))
+      {
+        throw std::out_of_range("Serialized message is shorter than its type.");
+      }
+      return data + count;
+    }
+
+    const char *MessageView::AdvanceArray(const char *data, size_t count, size_t element_size) const
+    {
+      //array sizes come from the message, so count * element_size could wrap around
+      if (element_size > 0 && count > static_cast<size_t>(data_ + size_ - data) / element_size)
+      {
+        throw std::out_of_range("Serialized message is shorter than its type.");
+      }
+      return data + count * element_size;
+    }
+
+    const char *MessageView::Align(const char *data, size_t alignment) const
+    {
+      if (layout_ != WireLayout::aligned)
+      {
+        return data;
+      }
+      return Advance(data, AlignmentPadding(data - data_, alignment));
+    }
+
+    size_t MessageView::ReadArraySize(const char **data) const
+    {
+      array_size_t size;
+      auto end = Advance(*data, sizeof(array_size_t));
+      std::memcpy(&size, *data, sizeof(array_size_t));
+      *data = end;
+      return size;
+    }
+
+    const char *MessageView::SkipMember(const MessageMember *member, const char *data) const
+    {
+      switch (member->type_id_)
+      {
+      case ts_introspection::ROS_TYPE_STRING:
+      {
+        size_t count = 1;
+        if (member->is_array_)
+        {
+          count = IsStaticArray(member) ? member->array_size_ : ReadArraySize(&data);
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+          auto str_size = ReadArraySize(&data);
+          data = Advance(data, str_size);
+        }
+        return data;
+      }
+      case ts_introspection::ROS_TYPE_MESSAGE:
+      {
+        auto sub_members = GetMembers(member);
+        size_t count = 1;
+        if (member->is_array_)
+        {
+          count = IsStaticArray(member) ? member->array_size_ : ReadArraySize(&data);
+        }
+        if (TypeInfo::IsMemcopyable(sub_members))
+        {
+          return AdvanceArray(data, count, sub_members->size_of_);
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+          data = Skip(sub_members, data);
+        }
+        return data;
+      }
+      default:
+      {
+        PrimitiveInfo info;
+        if (!GetPrimitiveInfo(member->type_id_, &info))
+        {
+          throw std::runtime_error(std::string{"Field '"} + member->name_ + "' has unsupported type.");
+        }
+        if (!member->is_array_)
+        {
+          return Advance(data, info.size);
+        }
+        size_t count = member->array_size_;
+        if (!IsStaticArray(member))
+        {
+          data = Align(data, alignof(array_size_t));
+          count = ReadArraySize(&data);
+        }
+        data = Align(data, info.alignment);
+        return AdvanceArray(data, count, info.size);
+      }
+      }
+    }
+
+    const char *MessageView::Skip(const MessageMembers *members, const char *data) const
+    {
+      if (TypeInfo::IsMemcopyable(members))
+      {
+        return Advance(data, members->size_of_);
+      }
+      for (uint32_t i = 0; i < members->member_count_; i++)
+      {
+        data = SkipMember(members->members_ + i, data);
+      }
+      return data;
+    }
+
+    MessageView::Field MessageView::FindField(const std::string &path) const
+    {
+      auto members = members_;
+      auto data = fields_;
+      bool in_struct = false;
+      size_t name_begin = 0;
+
+      while (true)
+      {
+        auto name_end = path.find('.', name_begin);
+        auto name = path.substr(name_begin, name_end == std::string::npos ? std::string::npos : name_end - name_begin);
+
+        const MessageMember *found = nullptr;
+        if (TypeInfo::IsMemcopyable(members))
+        {
+          //memcopyable messages are copied as they are laid out in memory
+          for (uint32_t i = 0; i < members->member_count_ && found == nullptr; i++)
+          {
+            if (name == members->members_[i].name_)
+            {
+              found = members->members_ + i;
+              Advance(data, members->size_of_);
+              data += found->offset_;
+              in_struct = true;
+            }
+          }
+        }
+        else
+        {
+          for (uint32_t i = 0; i < members->member_count_ && found == nullptr; i++)
+          {
+            if (name == members->members_[i].name_)
+            {
+              found = members->members_ + i;
+            }
+            else
+            {
+              data = SkipMember(members->members_ + i, data);
+            }
+          }
+        }
+
+        if (found == nullptr)
+        {
+          throw std::invalid_argument("Message has no field '" + path + "'.");
+        }
+        if (name_end == std::string::npos)
+        {
+          return Field{found, data, in_struct};
+        }
+        if (found->type_id_ != ts_introspection::ROS_TYPE_MESSAGE || found->is_array_)
+        {
+          throw std::invalid_argument("Field '" + name + "' is not a nested message.");
+        }
+        members = GetMembers(found);
+        name_begin = name_end + 1;
+      }
+    }
+
+    const void *MessageView::GetSingleData(const std::string &path, size_t element_size) const
+    {
+      auto field = FindField(path);
+      if (field.member->is_array_ || !MatchesElementSize(field.member, element_size))
+      {
+        throw std::invalid_argument("Field '" + path + "' doesn't match requested type.");
+      }
+      Advance(field.data, element_size);
+      return field.data;
+    }
+
+    const void *MessageView::GetArrayData(const std::string &path, size_t element_size, size_t element_alignment, size_t *count) const
+    {
+      auto field = FindField(path);
+      auto member = field.member;
+      if (!member->is_array_ || !MatchesElementSize(member, element_size))
+      {
+        throw std::invalid_argument("Field '" + path + "' doesn't match requested type.");
+      }
+
+      auto data = field.data;
+      *count = member->array_size_;
+      if (!field.in_struct)
+      {
+        if (!IsStaticArray(member))
+        {
+          data = Align(data, alignof(array_size_t));
+          *count = ReadArraySize(&data);
+        }
+        data = Align(data, element_alignment);
+      }
+      AdvanceArray(data, *count, element_size);
+
+      if (reinterpret_cast<uintptr_t>(data) % element_alignment != 0)
+      {
+        throw std::runtime_error("Field '" + path + "' is not aligned, publisher has to use aligned wire layout.");
+      }
+      return data;
+    }
+
+  } // namespace rmw
+} // namespace eCAL
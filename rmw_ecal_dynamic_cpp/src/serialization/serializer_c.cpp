@@ -15,6 +15,7 @@
 #include "serializer_c.hpp"
 
 #include <string>
+#include <utility>
 #include <stdexcept>
 #include <cstring>
 
@@ -27,54 +28,61 @@
 
 #include "common.hpp"
 #include "type_info.hpp"
+#include "bulk_copy.hpp"
 
 namespace eCAL
 {
   namespace rmw
   {
 
+    void CSerializer::Align(size_t alignment, SerializedSegments &serialized_data) const
+    {
+      if (layout_ == WireLayout::aligned)
+      {
+        serialized_data.Append(AlignmentPadding(serialized_data.Size(), alignment), '\0');
+      }
+    }
+
     template <typename T>
-    void CSerializer::SerializeSingle(const char *data, std::string &serialized_data) const
+    void CSerializer::SerializeSingle(const char *data, SerializedSegments &serialized_data) const
     {
-      serialized_data.insert(serialized_data.end(), data, data + sizeof(T));
+      serialized_data.Append(data, sizeof(T));
     }
 
     template <typename T>
-    void CSerializer::SerializeSingle(const T &data, std::string &serialized_data) const
+    void CSerializer::SerializeSingle(const T &data, SerializedSegments &serialized_data) const
     {
       auto data_bytes = reinterpret_cast<const char *>(&data);
       SerializeSingle<T>(data_bytes, serialized_data);
     }
 
     template <>
-    void CSerializer::SerializeSingle<std::string>(const char *data, std::string &serialized_data) const
+    void CSerializer::SerializeSingle<std::string>(const char *data, SerializedSegments &serialized_data) const
     {
-      SerializeDynamicArray<char>(data, serialized_data);
+      //strings are never padded, so they don't go through SerializeDynamicArray
+      AppendStrings(reinterpret_cast<const rosidl_runtime_c__String *>(data), 1, serialized_data);
     }
 
     template <typename T>
-    void CSerializer::SerializeArray(const char *data, size_t count, std::string &serialized_data) const
+    void CSerializer::SerializeArray(const char *data, size_t count, SerializedSegments &serialized_data) const
     {
-      serialized_data.insert(serialized_data.end(), data, data + count * sizeof(T));
+      Align(ArrayAlignment<T>(), serialized_data);
+      serialized_data.AppendReferenced(data, count * sizeof(T));
       // TODO: PVS issue V1001 (https://www.viva64.com/en/w/v1001/print/)
       // what is this line supposed to do ?
       data += sizeof(T) * count;
     }
 
     template <>
-    void CSerializer::SerializeArray<std::string>(const char *data, size_t count, std::string &serialized_data) const
+    void CSerializer::SerializeArray<std::string>(const char *data, size_t count, SerializedSegments &serialized_data) const
     {
-      for (size_t i = 0; i < count; i++)
-      {
-        SerializeSingle<std::string>(data, serialized_data);
-        data += sizeof(rosidl_runtime_c__char__Sequence);
-      }
+      AppendStrings(reinterpret_cast<const rosidl_runtime_c__String *>(data), count, serialized_data);
     }
 
     template <>
     void CSerializer::SerializeArray<ros_message_t>(const char *data,
                                                     const rosidl_typesupport_introspection_c__MessageMember *member,
-                                                    std::string &serialized_data) const
+                                                    SerializedSegments &serialized_data) const
     {
       auto sub_members = GetMembers(member);
       auto member_size = sub_members->size_of_;
@@ -83,9 +91,7 @@ namespace eCAL
       if(TypeInfo::IsMemcopyable(sub_members))
       {
         auto data_size = member_size * array_size;
-        auto old_size = serialized_data.size();
-        serialized_data.resize(serialized_data.size() + data_size);
-        std::memcpy(&serialized_data[old_size], data, data_size);
+        serialized_data.AppendReferenced(data, data_size);
       }
       else
       {
@@ -98,17 +104,19 @@ namespace eCAL
     }
 
     template <typename T>
-    void CSerializer::SerializeDynamicArray(const char *data, std::string &serialized_data) const
+    void CSerializer::SerializeDynamicArray(const char *data, SerializedSegments &serialized_data) const
     {
       auto sequence = reinterpret_cast<const rosidl_runtime_c__char__Sequence *>(data);
 
-      serialized_data.reserve(serialized_data.size() + sequence->size * sizeof(T) + sizeof(array_size_t));
+      auto data_size = serialized_data.IsReferenced(sequence->size * sizeof(T)) ? 0 : sequence->size * sizeof(T);
+      serialized_data.Reserve(data_size + sizeof(array_size_t) + 2 * ArrayAlignment<T>());
+      Align(ArraySizeAlignment<T>(), serialized_data);
       SerializeSingle<array_size_t>(sequence->size, serialized_data);
       SerializeArray<T>(reinterpret_cast<const char *>(sequence->data), sequence->size, serialized_data);
     }
 
     template <>
-    void CSerializer::SerializeDynamicArray<std::string>(const char *data, std::string &serialized_data) const
+    void CSerializer::SerializeDynamicArray<std::string>(const char *data, SerializedSegments &serialized_data) const
     {
       auto sequence = reinterpret_cast<const rosidl_runtime_c__char__Sequence *>(data);
 
@@ -119,7 +127,7 @@ namespace eCAL
     template <>
     void CSerializer::SerializeDynamicArray<ros_message_t>(const char *data,
                                                            const rosidl_typesupport_introspection_c__MessageMember *member,
-                                                           std::string &serialized_data) const
+                                                           SerializedSegments &serialized_data) const
     {
       auto sequence = reinterpret_cast<const rosidl_runtime_c__char__Sequence *>(data);
       auto sequence_data = reinterpret_cast<const char *>(sequence->data);
@@ -129,9 +137,7 @@ namespace eCAL
       if(TypeInfo::IsMemcopyable(sub_members))
       {
 	auto data_size = sequence->size * sub_members->size_of_;
-	auto old_size = serialized_data.size();
-	serialized_data.resize(old_size + data_size);
-	std::memcpy(&serialized_data[old_size], sequence_data, data_size);
+        serialized_data.AppendReferenced(sequence_data, data_size);
       }
       else
       {
@@ -146,7 +152,7 @@ namespace eCAL
     template <typename T>
     void CSerializer::Serialize(const char *data,
                                 const rosidl_typesupport_introspection_c__MessageMember &member,
-                                std::string &serialized_data) const
+                                SerializedSegments &serialized_data) const
     {
       if (member.is_array_)
       {
@@ -169,7 +175,7 @@ namespace eCAL
     template <>
     void CSerializer::Serialize<ros_message_t>(const char *data,
                                                const rosidl_typesupport_introspection_c__MessageMember &member,
-                                               std::string &serialized_data) const
+                                               SerializedSegments &serialized_data) const
     {
       if (member.is_array_)
       {
@@ -191,14 +197,13 @@ namespace eCAL
 
     void CSerializer::SerializeMessage(const char *data,
                                        const rosidl_typesupport_introspection_c__MessageMembers *members,
-                                       std::string &serialized_data) const
+                                       SerializedSegments &serialized_data) const
     {
-      if (TypeInfo::IsMemcopyable(members))
+      const auto &layout = TypeInfo::GetLayout(members);
+      if (layout.memcopyable)
       {
         auto data_size = members->size_of_;
-	auto old_size = serialized_data.size();
-        serialized_data.resize(old_size + data_size);
-        std::memcpy(&serialized_data[old_size], data, data_size);
+        serialized_data.AppendReferenced(data, data_size);
         return;
       }
       for (uint32_t i = 0; i < members->member_count_; i++)
@@ -206,6 +211,15 @@ namespace eCAL
         auto member = members->members_ + i;
         auto member_data = data + member->offset_;
 
+        //consecutive primitive members without padding in between are copied at once
+        const auto &pod_run = layout.pod_runs[i];
+        if (pod_run.member_count > 1)
+        {
+          serialized_data.Append(member_data, pod_run.size);
+          i += pod_run.member_count - 1;
+          continue;
+        }
+
         switch (member->type_id_)
         {
         case ::rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
@@ -264,17 +278,26 @@ namespace eCAL
       }
     }
 
-    CSerializer::CSerializer(const rosidl_typesupport_introspection_c__MessageMembers *members)
-          : members_(members)
+    CSerializer::CSerializer(const rosidl_typesupport_introspection_c__MessageMembers *members, WireLayout layout)
+          : members_(members),
+            layout_(layout)
     {
       TypeInfo::AnalyzeType(members);
     }
 
     const std::string CSerializer::Serialize(const void *data)
     {
-      std::string serialized_data;
+      SerializedSegments serialized_data;
+      serialized_data.Reserve(LayoutHeaderSize(layout_) + TypeInfo::GetLayout(members_).serialized_size);
+      WriteLayoutHeader(layout_, serialized_data);
+      SerializeMessage(static_cast<const char *>(data), members_, serialized_data);
+      return std::move(serialized_data.Buffer());
+    }
+
+    void CSerializer::SerializeSegments(const void *data, SerializedSegments &serialized_data)
+    {
+      WriteLayoutHeader(layout_, serialized_data);
       SerializeMessage(static_cast<const char *>(data), members_, serialized_data);
-      return serialized_data;
     }
 
     const std::string CSerializer::GetMessageStringDescriptor() const
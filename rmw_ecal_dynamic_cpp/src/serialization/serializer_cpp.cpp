@@ -16,6 +16,7 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 #include <stdexcept>
 #include <cstring>
 
@@ -28,6 +29,7 @@
 #include <rosidl_runtime_c/string_functions.h>
 
 #include "type_info.hpp"
+#include "bulk_copy.hpp"
 #include "common.hpp"
 
 namespace eCAL
@@ -37,14 +39,22 @@ namespace eCAL
 
     namespace ts_introspection = rosidl_typesupport_introspection_cpp;
 
+    void CppSerializer::Align(size_t alignment, SerializedSegments &serialized_data) const
+    {
+      if (layout_ == WireLayout::aligned)
+      {
+        serialized_data.Append(AlignmentPadding(serialized_data.Size(), alignment), '\0');
+      }
+    }
+
     template <typename T>
-    void CppSerializer::SerializeSingle(const char *data, std::string &serialized_data) const
+    void CppSerializer::SerializeSingle(const char *data, SerializedSegments &serialized_data) const
     {
-      serialized_data.insert(serialized_data.end(), data, data + sizeof(T));
+      serialized_data.Append(data, sizeof(T));
     }
 
     template <typename T>
-    void CppSerializer::SerializeSingle(const T &data, std::string &serialized_data) const
+    void CppSerializer::SerializeSingle(const T &data, SerializedSegments &serialized_data) const
     {
       auto data_bytes = reinterpret_cast<const char *>(&data);
 
@@ -52,46 +62,38 @@ namespace eCAL
     }
 
     template <>
-    void CppSerializer::SerializeSingle<std::string>(const char *data, std::string &serialized_data) const
+    void CppSerializer::SerializeSingle<std::string>(const char *data, SerializedSegments &serialized_data) const
     {
-      auto str = reinterpret_cast<const std::string *>(data);
-      auto str_data = str->c_str();
-      auto str_size = str->size();
-
-      SerializeArraySize(*str, serialized_data);
-      SerializeArray<char>(str_data, str_size, serialized_data);
+      AppendStrings(reinterpret_cast<const std::string *>(data), 1, serialized_data);
     }
 
     template <typename ARR>
-    void CppSerializer::SerializeArraySize(const ARR &array, std::string &serialized_data) const
+    void CppSerializer::SerializeArraySize(const ARR &array, SerializedSegments &serialized_data) const
     {
       array_size_t size = array.size();
       SerializeSingle<array_size_t>(size, serialized_data);
     }
 
     template <typename T>
-    void CppSerializer::SerializeArray(const char *data, size_t count, std::string &serialized_data) const
+    void CppSerializer::SerializeArray(const char *data, size_t count, SerializedSegments &serialized_data) const
     {
-      serialized_data.insert(serialized_data.end(), data, data + count * sizeof(T));
+      Align(ArrayAlignment<T>(), serialized_data);
+      serialized_data.AppendReferenced(data, count * sizeof(T));
       // TODO: PVS issue V1001 (https://www.viva64.com/en/w/v1001/print/)
       // what is this line supposed to do ?
       data += sizeof(T) * count;
     }
 
     template <>
-    void CppSerializer::SerializeArray<std::string>(const char *data, size_t count, std::string &serialized_data) const
+    void CppSerializer::SerializeArray<std::string>(const char *data, size_t count, SerializedSegments &serialized_data) const
     {
-      for (size_t i = 0; i < count; i++)
-      {
-        SerializeSingle<std::string>(data, serialized_data);
-        data += sizeof(std::string);
-      }
+      AppendStrings(reinterpret_cast<const std::string *>(data), count, serialized_data);
     }
 
     template <>
     void CppSerializer::SerializeArray<ros_message_t>(const char *data,
                                                       const ts_introspection::MessageMember *member,
-                                                      std::string &serialized_data) const
+                                                      SerializedSegments &serialized_data) const
     {
       auto sub_members = GetMembers(member);
       auto member_size = sub_members->size_of_;
@@ -100,9 +102,7 @@ namespace eCAL
       if(TypeInfo::IsMemcopyable(sub_members))
       {
 	auto data_size = member_size * array_size;
-	auto old_size = serialized_data.size();
-	serialized_data.resize(serialized_data.size() + data_size);
-	std::memcpy(&serialized_data[old_size], data, data_size);
+        serialized_data.AppendReferenced(data, data_size);
       }
       else
       {
@@ -115,33 +115,37 @@ namespace eCAL
     }
 
     template <typename T>
-    void CppSerializer::SerializeDynamicArray(const char *data, std::string &serialized_data) const
+    void CppSerializer::SerializeDynamicArray(const char *data, SerializedSegments &serialized_data) const
     {
       auto &array = *reinterpret_cast<const std::vector<T> *>(data);
       auto array_data = reinterpret_cast<const char *>(array.data());
       auto array_size = array.size();
 
-      //reserve data for size and content of array to avoid multiple reallocations
-      serialized_data.reserve(serialized_data.size() + array_size * sizeof(T) + sizeof(array_size_t));
+      //reserve data for size and content of array to avoid multiple reallocations,
+      //large arrays are referenced in place so only their size has to fit
+      auto data_size = serialized_data.IsReferenced(array_size * sizeof(T)) ? 0 : array_size * sizeof(T);
+      serialized_data.Reserve(data_size + sizeof(array_size_t) + 2 * ArrayAlignment<T>());
 
+      Align(ArraySizeAlignment<T>(), serialized_data);
       SerializeArraySize(array, serialized_data);
       SerializeArray<T>(array_data, array_size, serialized_data);
     }
 
     template <>
-    void CppSerializer::SerializeDynamicArray<bool>(const char *data, std::string &serialized_data) const
+    void CppSerializer::SerializeDynamicArray<bool>(const char *data, SerializedSegments &serialized_data) const
     {
       auto &array = *reinterpret_cast<const std::vector<bool> *>(data);
-      serialized_data.reserve(serialized_data.size() + array.size() * sizeof(bool) + sizeof(array_size_t));
+      serialized_data.Reserve(array.size() * sizeof(bool) + sizeof(array_size_t) + ArraySizeAlignment<bool>());
 
+      Align(ArraySizeAlignment<bool>(), serialized_data);
       SerializeArraySize(array, serialized_data);
-      serialized_data.insert(serialized_data.end(), array.begin(), array.end());
+      CopyBoolsToBytes(array, serialized_data.Extend(array.size()));
     }
 
     template <>
     void CppSerializer::SerializeDynamicArray<ros_message_t>(const char *data,
                                                              const ts_introspection::MessageMember *member,
-                                                             std::string &serialized_data) const
+                                                             SerializedSegments &serialized_data) const
     {
       auto vector = reinterpret_cast<const std::vector<char> *>(data);
       auto sub_members = GetMembers(member);
@@ -151,9 +155,7 @@ namespace eCAL
       SerializeSingle(size, serialized_data);
       if(TypeInfo::IsMemcopyable(sub_members))
       {
-	auto old_size = serialized_data.size();
-	serialized_data.resize(old_size + vector->size());
-	std::memcpy(&serialized_data[old_size], vector->data(), vector->size());
+        serialized_data.AppendReferenced(vector->data(), vector->size());
       }
       else
       {
@@ -168,7 +170,7 @@ namespace eCAL
     template <typename T>
     void CppSerializer::Serialize(const char *data,
                                   const ts_introspection::MessageMember &member,
-                                  std::string &serialized_data) const
+                                  SerializedSegments &serialized_data) const
     {
       if (member.is_array_)
       {
@@ -191,7 +193,7 @@ namespace eCAL
     template <>
     void CppSerializer::Serialize<ros_message_t>(const char *data,
                                                  const ts_introspection::MessageMember &member,
-                                                 std::string &serialized_data) const
+                                                 SerializedSegments &serialized_data) const
     {
       if (member.is_array_)
       {
@@ -213,14 +215,13 @@ namespace eCAL
 
     void CppSerializer::SerializeMessage(const char *data,
                                          const ts_introspection::MessageMembers *members,
-                                         std::string &serialized_data) const
+                                         SerializedSegments &serialized_data) const
     {
-      if (TypeInfo::IsMemcopyable(members))
+      const auto &layout = TypeInfo::GetLayout(members);
+      if (layout.memcopyable)
       {
         auto data_size = members->size_of_;
-	auto old_size = serialized_data.size();
-        serialized_data.resize(old_size + data_size);
-        std::memcpy(&serialized_data[old_size], data, data_size);
+        serialized_data.AppendReferenced(data, data_size);
         return;
       }
 
@@ -229,6 +230,15 @@ namespace eCAL
         const auto member = members->members_ + i;
         const auto member_data = data + member->offset_;
 
+        //consecutive primitive members without padding in between are copied at once
+        const auto &pod_run = layout.pod_runs[i];
+        if (pod_run.member_count > 1)
+        {
+          serialized_data.Append(member_data, pod_run.size);
+          i += pod_run.member_count - 1;
+          continue;
+        }
+
         switch (member->type_id_)
         {
         case ts_introspection::ROS_TYPE_STRING:
@@ -287,18 +297,26 @@ namespace eCAL
       }
     }
 
-    CppSerializer::CppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
-          : members_(members)
+    CppSerializer::CppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout)
+          : members_(members),
+            layout_(layout)
     {
       TypeInfo::AnalyzeType(members);
     }
 
     const std::string CppSerializer::Serialize(const void *data)
     {
-      //it might be good idea to pre estimate and reserve data size in our payload vector
-      std::string serialized_data;
+      SerializedSegments serialized_data;
+      serialized_data.Reserve(LayoutHeaderSize(layout_) + TypeInfo::GetLayout(members_).serialized_size);
+      WriteLayoutHeader(layout_, serialized_data);
+      SerializeMessage(static_cast<const char *>(data), members_, serialized_data);
+      return std::move(serialized_data.Buffer());
+    }
+
+    void CppSerializer::SerializeSegments(const void *data, SerializedSegments &serialized_data)
+    {
+      WriteLayoutHeader(layout_, serialized_data);
       SerializeMessage(static_cast<const char *>(data), members_, serialized_data);
-      return serialized_data;
     }
 
     const std::string CppSerializer::GetMessageStringDescriptor() const
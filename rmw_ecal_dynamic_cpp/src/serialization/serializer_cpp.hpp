@@ -21,6 +21,8 @@
 
 #include <rmw_ecal_shared_cpp/serializer.hpp>
 
+#include "wire_layout.hpp"
+
 namespace eCAL
 {
   namespace rmw
@@ -29,45 +31,49 @@ namespace eCAL
     class CppSerializer : public Serializer
     {
       const rosidl_typesupport_introspection_cpp::MessageMembers *members_;
+      WireLayout layout_;
+
+      void Align(size_t alignment, SerializedSegments &serialized_data) const;
 
       template <typename T>
-      void SerializeSingle(const char *data, std::string &serialized_data) const;
+      void SerializeSingle(const char *data, SerializedSegments &serialized_data) const;
 
       template <typename T>
-      void SerializeSingle(const T &data, std::string &serialized_data) const;
+      void SerializeSingle(const T &data, SerializedSegments &serialized_data) const;
 
       template <typename ARR>
-      void SerializeArraySize(const ARR &array, std::string &serialized_data) const;
+      void SerializeArraySize(const ARR &array, SerializedSegments &serialized_data) const;
 
       template <typename T>
-      void SerializeArray(const char *data, size_t count, std::string &serialized_data) const;
+      void SerializeArray(const char *data, size_t count, SerializedSegments &serialized_data) const;
 
       template <typename T>
       void SerializeArray(const char *data,
                           const rosidl_typesupport_introspection_cpp::MessageMember *member,
-                          std::string &serialized_data) const;
+                          SerializedSegments &serialized_data) const;
 
       template <typename T>
-      void SerializeDynamicArray(const char *data, std::string &serialized_data) const;
+      void SerializeDynamicArray(const char *data, SerializedSegments &serialized_data) const;
 
       template <typename T>
       void SerializeDynamicArray(const char *data,
                                  const rosidl_typesupport_introspection_cpp::MessageMember *member,
-                                 std::string &serialized_data) const;
+                                 SerializedSegments &serialized_data) const;
 
       template <typename T>
       void Serialize(const char *data,
                      const rosidl_typesupport_introspection_cpp::MessageMember &member,
-                     std::string &serialized_data) const;
+                     SerializedSegments &serialized_data) const;
 
       void SerializeMessage(const char *data,
                             const rosidl_typesupport_introspection_cpp::MessageMembers *members,
-                            std::string &serialized_data) const;
+                            SerializedSegments &serialized_data) const;
 
     public:
-      explicit CppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members);
+      explicit CppSerializer(const rosidl_typesupport_introspection_cpp::MessageMembers *members, WireLayout layout = GetWireLayout());
 
       virtual const std::string Serialize(const void *data) override;
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data) override;
       virtual const std::string GetMessageStringDescriptor() const override;
     };
 
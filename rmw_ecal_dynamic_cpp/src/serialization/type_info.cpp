@@ -0,0 +1,288 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "type_info.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+
+#include "wire_layout.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    namespace TypeInfo
+    {
+
+    namespace
+    {
+      namespace ts_cpp = rosidl_typesupport_introspection_cpp;
+
+      using LayoutMap = std::unordered_map<const void *, const TypeLayout *>;
+      using LayoutStorage = std::vector<std::unique_ptr<const TypeLayout>>;
+
+      //C and C++ introspection share type ids, so C++ constants are used for both.
+      size_t GetPrimitiveSize(uint8_t type_id)
+      {
+        switch (type_id)
+        {
+        case ts_cpp::ROS_TYPE_BOOLEAN:
+          return sizeof(bool);
+        case ts_cpp::ROS_TYPE_BYTE:
+          return sizeof(uint8_t);
+        case ts_cpp::ROS_TYPE_CHAR:
+          return sizeof(char);
+        case ts_cpp::ROS_TYPE_FLOAT:
+          return sizeof(float);
+        case ts_cpp::ROS_TYPE_DOUBLE:
+          return sizeof(double);
+        case ts_cpp::ROS_TYPE_LONG_DOUBLE:
+          return sizeof(long double);
+        case ts_cpp::ROS_TYPE_INT8:
+          return sizeof(int8_t);
+        case ts_cpp::ROS_TYPE_INT16:
+          return sizeof(int16_t);
+        case ts_cpp::ROS_TYPE_INT32:
+          return sizeof(int32_t);
+        case ts_cpp::ROS_TYPE_INT64:
+          return sizeof(int64_t);
+        case ts_cpp::ROS_TYPE_UINT8:
+          return sizeof(uint8_t);
+        case ts_cpp::ROS_TYPE_UINT16:
+          return sizeof(uint16_t);
+        case ts_cpp::ROS_TYPE_UINT32:
+          return sizeof(uint32_t);
+        case ts_cpp::ROS_TYPE_UINT64:
+          return sizeof(uint64_t);
+        default:
+          throw std::logic_error("Field is not of primitive type.");
+        }
+      }
+
+      template <typename MessageMembers>
+      const TypeLayout &Analyze(const MessageMembers *members, LayoutMap &layouts, LayoutStorage &storage)
+      {
+        auto found = layouts.find(members);
+        if (found != layouts.end())
+        {
+          return *found->second;
+        }
+
+        std::unique_ptr<TypeLayout> layout{new TypeLayout{}};
+        layout->fixed_size = true;
+        layout->serialized_size = 0;
+        layout->pod_runs.assign(members->member_count_, PodRun{1, 0});
+        layout->bounded = true;
+        layout->max_serialized_size = 0;
+        //worst case padding in front of primitive arrays and their sizes, alignment never exceeds element size
+        const bool aligned = GetWireLayout() == WireLayout::aligned;
+
+        bool memcopyable = true;
+        size_t memory_size = 0;
+        //in-memory size of members which can be part of a pod run, 0 for others
+        std::vector<size_t> pod_sizes(members->member_count_, 0);
+
+        for (uint32_t i = 0; i < members->member_count_; i++)
+        {
+          const auto member = members->members_ + i;
+          const bool static_array = member->is_array_ && member->array_size_ > 0 && !member->is_upper_bound_;
+          const bool dynamic_array = member->is_array_ && !static_array;
+
+          //Detect if there was padding before this member
+          if (member->offset_ != memory_size)
+          {
+            memcopyable = false;
+          }
+
+          size_t element_size = 0;
+          size_t serialized_element_size = 0;
+          size_t max_element_size = 0;
+          size_t max_padding = 0;
+          size_t max_size_padding = 0;
+          bool element_fixed_size = true;
+          bool element_memcopyable = true;
+          bool element_bounded = true;
+
+          switch (member->type_id_)
+          {
+          case ts_cpp::ROS_TYPE_STRING:
+            serialized_element_size = sizeof(array_size_t);
+            max_element_size = sizeof(array_size_t) + member->string_upper_bound_;
+            element_fixed_size = false;
+            element_memcopyable = false;
+            element_bounded = member->string_upper_bound_ > 0;
+            break;
+          case ts_cpp::ROS_TYPE_MESSAGE:
+          {
+            auto sub_members = GetMembers(member);
+            const auto &sub_layout = Analyze(sub_members, layouts, storage);
+            element_size = sub_members->size_of_;
+            serialized_element_size = sub_layout.memcopyable ? sub_members->size_of_ : sub_layout.serialized_size;
+            max_element_size = sub_layout.memcopyable ? sub_members->size_of_ : sub_layout.max_serialized_size;
+            element_fixed_size = sub_layout.fixed_size;
+            element_memcopyable = sub_layout.memcopyable;
+            element_bounded = sub_layout.bounded;
+          }
+          break;
+            //not documented
+          case ts_cpp::ROS_TYPE_WSTRING:
+          case ts_cpp::ROS_TYPE_WCHAR:
+            throw std::logic_error("Wide character/string serialization is unsupported.");
+          default:
+            element_size = GetPrimitiveSize(member->type_id_);
+            serialized_element_size = element_size;
+            max_element_size = element_size;
+            max_padding = aligned && member->is_array_ ? element_size - 1 : 0;
+            max_size_padding = aligned && member->is_array_ ? alignof(array_size_t) - 1 : 0;
+            break;
+          }
+
+          if (dynamic_array)
+          {
+            memcopyable = false;
+            layout->fixed_size = false;
+            layout->serialized_size += sizeof(array_size_t);
+            //upper bounded sequences hold at most array_size_ elements
+            layout->bounded = layout->bounded && element_bounded && member->is_upper_bound_;
+            layout->max_serialized_size += max_size_padding + sizeof(array_size_t) +
+                                           max_padding + member->array_size_ * max_element_size;
+            continue;
+          }
+
+          const size_t count = static_array ? member->array_size_ : 1;
+          memcopyable = memcopyable && element_memcopyable;
+          layout->fixed_size = layout->fixed_size && element_fixed_size;
+          layout->serialized_size += count * serialized_element_size;
+          layout->bounded = layout->bounded && element_bounded;
+          layout->max_serialized_size += max_padding + count * max_element_size;
+          memory_size += count * element_size;
+
+          //static arrays are padded in aligned wire layout, so only single values form runs
+          if (!member->is_array_ && element_memcopyable)
+          {
+            pod_sizes[i] = element_size;
+          }
+        }
+        layout->memcopyable = memcopyable && memory_size == members->size_of_;
+        if (layout->memcopyable)
+        {
+          layout->max_serialized_size = members->size_of_;
+        }
+
+        for (uint32_t i = 0; i < members->member_count_;)
+        {
+          if (pod_sizes[i] == 0)
+          {
+            i++;
+            continue;
+          }
+          uint32_t end = i + 1;
+          size_t run_size = pod_sizes[i];
+          while (end < members->member_count_ && pod_sizes[end] != 0 &&
+                 members->members_[end].offset_ == members->members_[end - 1].offset_ + pod_sizes[end - 1])
+          {
+            run_size += pod_sizes[end];
+            end++;
+          }
+          layout->pod_runs[i] = PodRun{end - i, run_size};
+          i = end;
+        }
+
+        layouts.emplace(members, layout.get());
+        storage.push_back(std::move(layout));
+        return *storage.back();
+      }
+
+      //Serializers look up layouts of nested messages for every element, so lookups must not lock.
+      //They read immutable map published through atomic pointer, registration publishes extended copy.
+      //Registered layouts are never modified or removed and replaced maps are kept (one per registered
+      //type, lookups might still read them), so references returned by lookups stay valid.
+      class LayoutRegistry
+      {
+        std::mutex mutex_;
+        std::atomic<const LayoutMap *> layouts_;
+        std::vector<std::unique_ptr<const LayoutMap>> snapshots_;
+        LayoutStorage storage_;
+
+      public:
+        LayoutRegistry()
+        {
+          snapshots_.emplace_back(new LayoutMap{});
+          layouts_.store(snapshots_.back().get());
+        }
+
+        const TypeLayout *Find(const void *members) const
+        {
+          auto layouts = layouts_.load(std::memory_order_acquire);
+          auto found = layouts->find(members);
+          return found != layouts->end() ? found->second : nullptr;
+        }
+
+        template <typename MessageMembers>
+        const TypeLayout &Register(const MessageMembers *members)
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto current = layouts_.load(std::memory_order_relaxed);
+          auto found = current->find(members);
+          if (found != current->end())
+          {
+            return *found->second;
+          }
+          //nested types are registered together with the type containing them
+          std::unique_ptr<LayoutMap> layouts{new LayoutMap{*current}};
+          const auto &layout = Analyze(members, *layouts, storage_);
+          snapshots_.push_back(std::move(layouts));
+          layouts_.store(snapshots_.back().get(), std::memory_order_release);
+          return layout;
+        }
+      };
+
+      LayoutRegistry &GetRegistry()
+      {
+        static LayoutRegistry registry;
+        return registry;
+      }
+
+      template <typename MessageMembers>
+      const TypeLayout &GetRegisteredLayout(const MessageMembers *members)
+      {
+        auto &registry = GetRegistry();
+        auto layout = registry.Find(members);
+        if (layout != nullptr)
+        {
+          return *layout;
+        }
+        return registry.Register(members);
+      }
+    } // namespace
+
+    const TypeLayout &GetLayout(const rosidl_typesupport_introspection_cpp::MessageMembers *members)
+    {
+      return GetRegisteredLayout(members);
+    }
+
+    const TypeLayout &GetLayout(const rosidl_typesupport_introspection_c__MessageMembers *members)
+    {
+      return GetRegisteredLayout(members);
+    }
+
+    } // namespace TypeInfo
+  } // namespace rmw
+} // namespace eCAL
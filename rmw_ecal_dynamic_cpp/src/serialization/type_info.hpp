@@ -15,13 +15,12 @@
 
 #pragma once
 
-#include <unordered_set>
-#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
 
 #include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
-#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
 #include <rosidl_typesupport_introspection_c/message_introspection.h>
-#include <rosidl_typesupport_introspection_c/field_types.h>
 
 #include "common.hpp"
 
@@ -32,234 +31,51 @@ namespace eCAL
     namespace TypeInfo
     {
 
-    namespace ts_cpp = rosidl_typesupport_introspection_cpp;
-
-    static std::unordered_set<const char*> analyzed_types_;
-    static std::unordered_set<const char*> memcopyable_types_;
-
-    template<typename ts_introspection>
-    inline void SetAnalyzed(const ts_introspection *members)
+    //Consecutive members which are copied as a single block.
+    struct PodRun
     {
-      auto type_id = members->message_name_;
-      analyzed_types_.emplace(type_id);
-    }
-
-    template<typename ts_introspection>
-    inline bool AlreadyAnalyzed(const ts_introspection *members)
+      //number of members (starting with the one this run belongs to) in the block
+      uint32_t member_count;
+      //size of the block in bytes
+      size_t size;
+    };
+
+    //Layout facts computed once per message type.
+    struct TypeLayout
     {
-      auto type_id = members->message_name_;
-      return analyzed_types_.find(type_id) != analyzed_types_.end();
-    }
-
-    template<typename ts_introspection>
-    inline void SetMemcopyable(const ts_introspection *members)
+      //message is serialized as a single copy of its memory
+      bool memcopyable;
+      //message has no strings or dynamic arrays, so its serialized size doesn't depend on content
+      bool fixed_size;
+      //serialized size in packed layout, for types without fixed size
+      //it's the size with all strings and dynamic arrays empty
+      size_t serialized_size;
+      //one entry per member, runs of single primitive members without padding in between,
+      //run with member_count < 2 means member has to be serialized on its own
+      std::vector<PodRun> pod_runs;
+      //message has only bounded strings and sequences, so its serialized size is limited
+      bool bounded;
+      //upper bound of serialized size in process wire layout, valid only for bounded types
+      size_t max_serialized_size;
+    };
+
+    //Process wide registry keyed by MessageMembers identity. Types are analyzed
+    //on first use, following lookups don't lock.
+    const TypeLayout &GetLayout(const rosidl_typesupport_introspection_cpp::MessageMembers *members);
+    const TypeLayout &GetLayout(const rosidl_typesupport_introspection_c__MessageMembers *members);
+
+    template <typename ts_introspection>
+    inline void AnalyzeType(const ts_introspection *members)
     {
-      auto type_id = members->message_name_;
-      memcopyable_types_.emplace(type_id);
+      GetLayout(members);
     }
 
-    template<typename ts_introspection>
+    template <typename ts_introspection>
     inline bool IsMemcopyable(const ts_introspection *members)
     {
-      auto type_id = members->message_name_;
-      return memcopyable_types_.find(type_id) != memcopyable_types_.end();
-    }
-
-    inline void AnalyzeType(const ts_cpp::MessageMembers *members)
-    {
-      if(AlreadyAnalyzed(members)) return;
-
-      bool memcpyable = true;
-      auto struct_size = members->size_of_;
-      size_t actual_data_size = 0;
-
-      for (uint32_t i = 0; i < members->member_count_; i++)
-      {
-        const auto member = members->members_ + i;
-
-	//Detect if there was padding before this member
-	if(member->offset_ != actual_data_size)
-	{
-	  memcpyable = false;
-	}
-        if (member->is_array_)
-        {
-          if (!(member->array_size_ > 0 && !member->is_upper_bound_))
-          {
-            memcpyable = false;
-          }
-        }
-        switch (member->type_id_)
-        {
-        case ts_cpp::ROS_TYPE_STRING:
-	  memcpyable = false;
-          return;
-        case ts_cpp::ROS_TYPE_BOOLEAN:
-          actual_data_size += sizeof(bool);
-          break;
-        case ts_cpp::ROS_TYPE_BYTE:
-          actual_data_size += sizeof(uint8_t);
-          break;
-        case ts_cpp::ROS_TYPE_CHAR:
-          actual_data_size += sizeof(char);
-          break;
-        case ts_cpp::ROS_TYPE_FLOAT:
-          actual_data_size += sizeof(float);
-          break;
-        case ts_cpp::ROS_TYPE_DOUBLE:
-          actual_data_size += sizeof(double);
-          break;
-        case ts_cpp::ROS_TYPE_LONG_DOUBLE:
-          actual_data_size += sizeof(long double);
-          break;
-        case ts_cpp::ROS_TYPE_INT8:
-          actual_data_size += sizeof(int8_t);
-          break;
-        case ts_cpp::ROS_TYPE_INT16:
-          actual_data_size += sizeof(int16_t);
-          break;
-        case ts_cpp::ROS_TYPE_INT32:
-          actual_data_size += sizeof(int32_t);
-          break;
-        case ts_cpp::ROS_TYPE_INT64:
-          actual_data_size += sizeof(int64_t);
-          break;
-        case ts_cpp::ROS_TYPE_UINT8:
-          actual_data_size += sizeof(uint8_t);
-          break;
-        case ts_cpp::ROS_TYPE_UINT16:
-          actual_data_size += sizeof(uint16_t);
-          break;
-        case ts_cpp::ROS_TYPE_UINT32:
-          actual_data_size += sizeof(uint32_t);
-          break;
-        case ts_cpp::ROS_TYPE_UINT64:
-          actual_data_size += sizeof(uint64_t);
-	  break;
-        case ts_cpp::ROS_TYPE_MESSAGE:
-	  {
-            auto msg_members = GetMembers(member);
-	    AnalyzeType(msg_members);
-	    if(IsMemcopyable(msg_members))
-	    {
-              actual_data_size += msg_members->size_of_;
-	    }
-	    else
-	    {
-              memcpyable = false;
-	    }
-	  }
-          break;
-          //not documented
-        case ts_cpp::ROS_TYPE_WSTRING:
-        case ts_cpp::ROS_TYPE_WCHAR:
-          throw std::logic_error("Wide character/string serialization is unsupported.");
-	}
-      }
-
-      SetAnalyzed(members);
-      if(actual_data_size == struct_size && memcpyable)
-      {
-	SetMemcopyable(members);
-      }
+      return GetLayout(members).memcopyable;
     }
 
-    inline void AnalyzeType(const rosidl_typesupport_introspection_c__MessageMembers *members)
-    {
-      if(AlreadyAnalyzed(members)) return;
-
-      bool memcpyable = true;
-      auto struct_size = members->size_of_;
-      size_t actual_data_size = 0;
-
-      for (uint32_t i = 0; i < members->member_count_; i++)
-      {
-        const auto member = members->members_ + i;
-
-	//Detect if there was padding before this member
-	if(member->offset_ != actual_data_size)
-	{
-	  memcpyable = false;
-	}
-        if (member->is_array_)
-        {
-          if (!(member->array_size_ > 0 && !member->is_upper_bound_))
-          {
-            memcpyable = false;
-          }
-        }
-        switch (member->type_id_)
-        {
-        case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
-	  memcpyable = false;
-          return;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
-          actual_data_size += sizeof(bool);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_BYTE:
-          actual_data_size += sizeof(uint8_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
-        case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
-          actual_data_size += sizeof(float);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
-          actual_data_size += sizeof(double);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
-          actual_data_size += sizeof(long double);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
-          actual_data_size += sizeof(int8_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
-          actual_data_size += sizeof(int16_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
-          actual_data_size += sizeof(int32_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
-          actual_data_size += sizeof(int64_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
-          actual_data_size += sizeof(uint8_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
-          actual_data_size += sizeof(uint16_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
-          actual_data_size += sizeof(uint32_t);
-          break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
-          actual_data_size += sizeof(uint64_t);
-	  break;
-        case rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE:
-	  {
-            auto msg_members = GetMembers(member);
-	    AnalyzeType(msg_members);
-	    if(IsMemcopyable(msg_members))
-	    {
-              actual_data_size += msg_members->size_of_;
-	    }
-	    else
-	    {
-              memcpyable = false;
-	    }
-	  }
-          break;
-          //not documented
-        case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
-        case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
-          throw std::logic_error("Wide character/string serialization is unsupported.");
-	}
-      }
-
-      SetAnalyzed(members);
-      if(actual_data_size == struct_size && memcpyable)
-      {
-	SetMemcopyable(members);
-      }
-    }
-    }
+    } // namespace TypeInfo
   } // namespace rmw
 } // namespace eCAL
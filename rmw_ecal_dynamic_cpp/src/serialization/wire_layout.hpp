@@ -0,0 +1,104 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
+#include <rmw_ecal_dynamic_cpp/wire_layout.hpp>
+
+#include "common.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Layout has to match between publisher and subscriber processes, so it is
+    //selected once per process through RMW_ECAL_WIRE_LAYOUT environment variable.
+    inline WireLayout GetWireLayout()
+    {
+      static const WireLayout layout = [] {
+        auto value = std::getenv("RMW_ECAL_WIRE_LAYOUT");
+        if (value != nullptr && std::strcmp(value, "aligned") == 0)
+        {
+          return WireLayout::aligned;
+        }
+        return WireLayout::packed;
+      }();
+      return layout;
+    }
+
+    //Aligned messages start with this marker, so processes using the other layout reject them instead of
+    //misparsing them. Its size keeps offsets of following fields aligned. Packed messages have no marker,
+    //so they stay compatible with older releases.
+    constexpr size_t layout_marker_size = 8;
+    constexpr char aligned_layout_marker[layout_marker_size] = {'\xEC', 'A', 'L', 'I', 'G', 'N', 'E', 'D'};
+
+    inline size_t LayoutHeaderSize(WireLayout layout)
+    {
+      return layout == WireLayout::aligned ? layout_marker_size : 0;
+    }
+
+    inline void WriteLayoutHeader(WireLayout layout, SerializedSegments &serialized_data)
+    {
+      if (layout == WireLayout::aligned)
+      {
+        serialized_data.Append(aligned_layout_marker, layout_marker_size);
+      }
+    }
+
+    inline bool MatchesLayout(WireLayout layout, const void *serialized_data, size_t size)
+    {
+      const bool marked = size >= layout_marker_size &&
+                          std::memcmp(serialized_data, aligned_layout_marker, layout_marker_size) == 0;
+      return marked == (layout == WireLayout::aligned);
+    }
+
+    //Returns first field of message serialized in given layout.
+    inline const char *SkipLayoutHeader(WireLayout layout, const void *serialized_data, size_t size)
+    {
+      if (!MatchesLayout(layout, serialized_data, size))
+      {
+        throw std::runtime_error("Serialized message was written in a different wire layout (RMW_ECAL_WIRE_LAYOUT).");
+      }
+      return static_cast<const char *>(serialized_data) + LayoutHeaderSize(layout);
+    }
+
+    inline size_t AlignmentPadding(size_t offset, size_t alignment)
+    {
+      auto remainder = offset % alignment;
+      return remainder == 0 ? 0 : alignment - remainder;
+    }
+
+    //Only primitive arrays are padded, strings and nested messages are always packed.
+    template <typename T>
+    constexpr size_t ArrayAlignment()
+    {
+      return std::is_arithmetic<T>::value ? alignof(T) : 1;
+    }
+
+    template <typename T>
+    constexpr size_t ArraySizeAlignment()
+    {
+      return std::is_arithmetic<T>::value ? alignof(array_size_t) : 1;
+    }
+
+  } // namespace rmw
+} // namespace eCAL
@@ -76,11 +76,21 @@ namespace eCAL
         return serializer_->Serialize(data);
       }
 
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data) override
+      {
+        serializer_->SerializeSegments(data, serialized_data);
+      }
+
       virtual void Deserialize(void *message, const void *serialized_data, size_t size) override
       {
         deserializer_->Deserialize(message, serialized_data, size);
       }
 
+      virtual bool CanDeserialize(const void *serialized_data, size_t size) const override
+      {
+        return MatchesLayout(GetWireLayout(), serialized_data, size);
+      }
+
       virtual std::string GetTypeDescriptor() const override
       {
         return serializer_->GetMessageStringDescriptor();
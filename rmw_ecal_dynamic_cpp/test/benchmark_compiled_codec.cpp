@@ -0,0 +1,108 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//Time per message of generic introspection codecs (CppSerializer, CppDeserializer) and compiled codecs
+//for the high bandwidth standard types, both write the same bytes. Only C++ typesupport has compiled codecs.
+//  benchmark_compiled_codec [iterations]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "serialization/serializer_cpp.hpp"
+#include "serialization/deserializer_cpp.hpp"
+#include "serialization/compiled_codec_cpp.hpp"
+
+#include "test_messages.hpp"
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  template <typename Func>
+  double MeasureNs(long iterations, Func func)
+  {
+    //first run allocates receive buffers and registers layouts
+    func();
+    auto start = Clock::now();
+    for (long i = 0; i < iterations; i++)
+    {
+      func();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  }
+
+  void PrintResult(const std::string &name, const std::string &operation, double generic_ns, double compiled_ns)
+  {
+    std::cout << std::left << std::setw(18) << name << std::setw(13) << operation << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << generic_ns << std::setw(12) << compiled_ns << std::setw(9) << generic_ns / compiled_ns << "x" << std::endl;
+  }
+
+  template <typename T>
+  void Run(const std::string &name, const test_msgs::MessageDescription &description, const T &message, long iterations)
+  {
+    auto members = description.Members();
+    eCAL::rmw::CppSerializer generic_serializer{members};
+    eCAL::rmw::CompiledCppSerializer compiled_serializer{members};
+    eCAL::rmw::CppDeserializer generic_deserializer{members};
+    eCAL::rmw::CompiledCppDeserializer compiled_deserializer{members};
+
+    const auto serialized = generic_serializer.Serialize(&message);
+    if (serialized != compiled_serializer.Serialize(&message))
+    {
+      std::cerr << name << ": compiled codec writes different bytes" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
+    size_t size = 0;
+    auto generic_ns = MeasureNs(iterations, [&] { size += generic_serializer.Serialize(&message).size(); });
+    auto compiled_ns = MeasureNs(iterations, [&] { size += compiled_serializer.Serialize(&message).size(); });
+    PrintResult(name, "serialize", generic_ns, compiled_ns);
+
+    T result{};
+    generic_ns = MeasureNs(iterations, [&] { generic_deserializer.Deserialize(&result, serialized.data(), serialized.size()); });
+    compiled_ns = MeasureNs(iterations, [&] { compiled_deserializer.Deserialize(&result, serialized.data(), serialized.size()); });
+    PrintResult(name, "deserialize", generic_ns, compiled_ns);
+
+    //keeps serialization from being optimized away
+    if (size == 0)
+    {
+      std::cerr << name << ": nothing serialized" << std::endl;
+    }
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  long iterations = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 100000;
+  if (iterations <= 0)
+  {
+    std::cerr << "usage: benchmark_compiled_codec [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::left << std::setw(18) << "type" << std::setw(13) << "operation" << std::right
+            << std::setw(12) << "generic ns" << std::setw(12) << "compiled ns" << std::setw(10) << "speedup" << std::endl;
+  const auto &types = test_msgs::GetDescriptions();
+  Run("Image", types.image, test_msgs::MakeImage(), iterations);
+  Run("CompressedImage", types.compressed_image, test_msgs::MakeCompressedImage(), iterations);
+  Run("PointCloud2", types.point_cloud2, test_msgs::MakePointCloud2(), iterations);
+  Run("LaserScan", types.laser_scan, test_msgs::MakeLaserScan(), iterations);
+  Run("Imu", types.imu, test_msgs::MakeImu(), iterations);
+  Run("TFMessage", types.tf_message, test_msgs::MakeTFMessage(), iterations);
+  Run("Odometry", types.odometry, test_msgs::MakeOdometry(), iterations);
+  return EXIT_SUCCESS;
+}
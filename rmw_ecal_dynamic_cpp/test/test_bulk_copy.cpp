@@ -0,0 +1,119 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "serialization/bulk_copy.hpp"
+
+using namespace eCAL::rmw;
+
+TEST(BulkCopy, ExpandAndPackAllBitPatterns)
+{
+  for (unsigned bits = 0; bits < 256; bits++)
+  {
+    auto bytes = ExpandBits(static_cast<uint8_t>(bits));
+    unsigned char expanded[8];
+    std::memcpy(expanded, &bytes, sizeof(bytes));
+    for (int b = 0; b < 8; b++)
+    {
+      EXPECT_EQ((bits >> b) & 1u, expanded[b]);
+    }
+    EXPECT_EQ(bits, PackBytes(bytes));
+  }
+}
+
+TEST(BulkCopy, PackTreatsAnyNonZeroByteAsTrue)
+{
+  const unsigned char values[] = {0x00, 0x01, 0x02, 0x7f, 0x80, 0xfe, 0xff};
+  for (auto low : values)
+  {
+    for (auto high : values)
+    {
+      unsigned char bytes[8] = {low, 0, 0, high, 0, 0, 0, high};
+      uint64_t word;
+      std::memcpy(&word, bytes, sizeof(word));
+      unsigned expected = (low != 0 ? 0x01u : 0u) | (high != 0 ? 0x88u : 0u);
+      EXPECT_EQ(expected, PackBytes(word)) << int(low) << " " << int(high);
+    }
+  }
+}
+
+//Sizes around word boundaries, so both bulk and element wise parts are covered.
+TEST(BulkCopy, BoolVectorRoundTrip)
+{
+  for (size_t size = 0; size < 300; size++)
+  {
+    std::vector<bool> array;
+    for (size_t i = 0; i < size; i++)
+    {
+      array.push_back((i * 7) % 3 == 0 || i % 64 == 63);
+    }
+
+    std::string bytes(size, '\x55');
+    CopyBoolsToBytes(array, &bytes[0]);
+    for (size_t i = 0; i < size; i++)
+    {
+      ASSERT_EQ(array[i] ? 1 : 0, bytes[i]) << "size " << size << " index " << i;
+    }
+
+    //previous content and capacity must not leak into result
+    std::vector<bool> result(size * 2 + 5, true);
+    CopyBytesToBools(bytes.data(), size, result);
+    EXPECT_EQ(array, result) << "size " << size;
+  }
+}
+
+TEST(BulkCopy, BytesToBoolsAcceptsNonCanonicalTrue)
+{
+  std::string bytes(130, '\0');
+  for (size_t i = 0; i < bytes.size(); i += 3)
+  {
+    bytes[i] = static_cast<char>(0x80 | i);
+  }
+  std::vector<bool> result;
+  CopyBytesToBools(bytes.data(), bytes.size(), result);
+  ASSERT_EQ(bytes.size(), result.size());
+  for (size_t i = 0; i < bytes.size(); i++)
+  {
+    EXPECT_EQ(i % 3 == 0, result[i]) << i;
+  }
+}
+
+TEST(BulkCopy, AppendStrings)
+{
+  const std::string strings[] = {"", "abc", std::string(1000, 'x')};
+  std::string expected;
+  for (const auto &str : strings)
+  {
+    array_size_t size = str.size();
+    expected.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    expected += str;
+  }
+
+  //copied into single block and with large string referenced
+  for (size_t threshold : {std::numeric_limits<size_t>::max(), size_t{100}})
+  {
+    SerializedSegments serialized_data{threshold};
+    AppendStrings(strings, 3, serialized_data);
+    std::string result(serialized_data.Size(), '\0');
+    serialized_data.CopyTo(&result[0]);
+    EXPECT_EQ(expected, result);
+  }
+}
@@ -0,0 +1,129 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
+#include "serialization/serializer_cpp.hpp"
+#include "serialization/deserializer_cpp.hpp"
+#include "serialization/compiled_codec_cpp.hpp"
+
+#include "test_messages.hpp"
+
+namespace
+{
+  using eCAL::rmw::SerializedSegments;
+  using test_msgs::MessageDescription;
+
+  std::string Gather(eCAL::rmw::Serializer &serializer, const void *message)
+  {
+    //small threshold so large arrays are referenced instead of copied
+    SerializedSegments segments{64};
+    serializer.SerializeSegments(message, segments);
+    std::string gathered(segments.Size(), '\0');
+    segments.CopyTo(&gathered[0]);
+    return gathered;
+  }
+
+  //Compiled codec has to produce the same bytes as generic serializer and
+  //both deserializers have to accept what the other one wrote.
+  template <typename T>
+  void ExpectCompatible(const MessageDescription &description, const T &message)
+  {
+    auto members = description.Members();
+    ASSERT_TRUE(eCAL::rmw::HasCompiledCodec(members));
+
+    eCAL::rmw::CppSerializer generic_serializer{members};
+    eCAL::rmw::CompiledCppSerializer compiled_serializer{members};
+    const auto expected = generic_serializer.Serialize(&message);
+    EXPECT_EQ(expected, compiled_serializer.Serialize(&message));
+    EXPECT_EQ(expected, Gather(compiled_serializer, &message));
+
+    eCAL::rmw::CppDeserializer generic_deserializer{members};
+    eCAL::rmw::CompiledCppDeserializer compiled_deserializer{members};
+
+    T compiled_result{};
+    compiled_deserializer.Deserialize(&compiled_result, expected.data(), expected.size());
+    EXPECT_EQ(expected, generic_serializer.Serialize(&compiled_result));
+
+    T generic_result{};
+    generic_deserializer.Deserialize(&generic_result, expected.data(), expected.size());
+    EXPECT_EQ(expected, compiled_serializer.Serialize(&generic_result));
+
+    //deserializing again into a used message must not leave stale content behind
+    T empty{};
+    const auto empty_serialized = generic_serializer.Serialize(&empty);
+    compiled_deserializer.Deserialize(&compiled_result, empty_serialized.data(), empty_serialized.size());
+    EXPECT_EQ(empty_serialized, generic_serializer.Serialize(&compiled_result));
+  }
+
+  const test_msgs::Descriptions &Types()
+  {
+    return test_msgs::GetDescriptions();
+  }
+} // namespace
+
+TEST(CompiledCodec, Image)
+{
+  ExpectCompatible(Types().image, test_msgs::MakeImage());
+}
+
+TEST(CompiledCodec, CompressedImage)
+{
+  ExpectCompatible(Types().compressed_image, test_msgs::MakeCompressedImage());
+}
+
+TEST(CompiledCodec, PointCloud2)
+{
+  ExpectCompatible(Types().point_cloud2, test_msgs::MakePointCloud2());
+}
+
+TEST(CompiledCodec, LaserScan)
+{
+  ExpectCompatible(Types().laser_scan, test_msgs::MakeLaserScan());
+}
+
+TEST(CompiledCodec, Imu)
+{
+  ExpectCompatible(Types().imu, test_msgs::MakeImu());
+}
+
+TEST(CompiledCodec, TFMessage)
+{
+  ExpectCompatible(Types().tf_message, test_msgs::MakeTFMessage());
+}
+
+TEST(CompiledCodec, Odometry)
+{
+  ExpectCompatible(Types().odometry, test_msgs::MakeOdometry());
+}
+
+TEST(CompiledCodec, Misc)
+{
+  ExpectCompatible(Types().misc, test_msgs::MakeMisc());
+}
+
+TEST(CompiledCodec, RejectsWideStrings)
+{
+  struct WideMessage
+  {
+    std::u16string text;
+  };
+  MessageDescription wide{"Wide", sizeof(WideMessage)};
+  wide.Value("text", rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING, offsetof(WideMessage, text));
+  EXPECT_FALSE(eCAL::rmw::HasCompiledCodec(wide.Members()));
+}
@@ -0,0 +1,205 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rmw_ecal_dynamic_cpp/message_view.hpp"
+
+#include "serialization/serializer_cpp.hpp"
+#include "serialization/wire_layout.hpp"
+
+#include "test_messages.hpp"
+
+namespace
+{
+  namespace ts_introspection = rosidl_typesupport_introspection_cpp;
+  using eCAL::rmw::MessageView;
+  using eCAL::rmw::WireLayout;
+  using test_msgs::MessageDescription;
+
+  template <typename T>
+  std::string Serialize(const MessageDescription &description, const T &message)
+  {
+    eCAL::rmw::CppSerializer serializer{description.Members()};
+    return serializer.Serialize(&message);
+  }
+
+  //View of a message serialized by this process.
+  MessageView View(const MessageDescription &description, const std::string &serialized)
+  {
+    return MessageView{description.TypeSupport(), serialized.data(), serialized.size(), eCAL::rmw::GetWireLayout()};
+  }
+
+  template <typename T>
+  void ExpectArray(const std::vector<T> &expected, const MessageView &view, const std::string &path)
+  {
+    try
+    {
+      auto array = view.GetArray<T>(path);
+      EXPECT_EQ(expected, std::vector<T>(array.begin(), array.end()));
+    }
+    catch (const std::runtime_error &)
+    {
+      //packed layout gives no guarantee about alignment of array data
+      EXPECT_EQ(WireLayout::packed, eCAL::rmw::GetWireLayout()) << path;
+    }
+  }
+
+  const test_msgs::Descriptions &Types()
+  {
+    return test_msgs::GetDescriptions();
+  }
+} // namespace
+
+TEST(MessageView, SingleFields)
+{
+  auto image = test_msgs::MakeImage();
+  auto serialized = Serialize(Types().image, image);
+  auto view = View(Types().image, serialized);
+
+  EXPECT_EQ(image.header.stamp.sec, view.Get<int32_t>("header.stamp.sec"));
+  EXPECT_EQ(image.header.stamp.nanosec, view.Get<uint32_t>("header.stamp.nanosec"));
+  EXPECT_EQ(image.height, view.Get<uint32_t>("height"));
+  EXPECT_EQ(image.width, view.Get<uint32_t>("width"));
+  EXPECT_EQ(image.step, view.Get<uint32_t>("step"));
+}
+
+TEST(MessageView, FieldsInsideMemcopyableMessages)
+{
+  auto odometry = test_msgs::MakeOdometry();
+  auto serialized = Serialize(Types().odometry, odometry);
+  auto view = View(Types().odometry, serialized);
+
+  EXPECT_EQ(odometry.pose.pose.position.y, view.Get<double>("pose.pose.position.y"));
+  EXPECT_EQ(odometry.twist.twist.angular.z, view.Get<double>("twist.twist.angular.z"));
+}
+
+TEST(MessageView, Arrays)
+{
+  auto image = test_msgs::MakeImage();
+  auto image_serialized = Serialize(Types().image, image);
+  ExpectArray(image.data, View(Types().image, image_serialized), "data");
+
+  auto scan = test_msgs::MakeLaserScan();
+  auto scan_serialized = Serialize(Types().laser_scan, scan);
+  auto scan_view = View(Types().laser_scan, scan_serialized);
+  ExpectArray(scan.ranges, scan_view, "ranges");
+  ExpectArray(scan.intensities, scan_view, "intensities");
+
+  auto imu = test_msgs::MakeImu();
+  auto imu_serialized = Serialize(Types().imu, imu);
+  ExpectArray(std::vector<double>(imu.angular_velocity_covariance, imu.angular_velocity_covariance + 9),
+              View(Types().imu, imu_serialized), "angular_velocity_covariance");
+
+  auto misc = test_msgs::MakeMisc();
+  auto misc_serialized = Serialize(Types().misc, misc);
+  auto misc_view = View(Types().misc, misc_serialized);
+  ExpectArray(std::vector<int16_t>(misc.small, misc.small + 5), misc_view, "small");
+  ExpectArray(misc.large, misc_view, "large");
+  ExpectArray(misc.bounded, misc_view, "bounded");
+}
+
+//Layout is taken from the caller, not from RMW_ECAL_WIRE_LAYOUT of this process.
+TEST(MessageView, UsesWriterLayout)
+{
+  struct Padded
+  {
+    uint8_t flag;
+    std::vector<uint32_t> values;
+  };
+  MessageDescription padded{"Padded", sizeof(Padded)};
+  padded.Value("flag", ts_introspection::ROS_TYPE_UINT8, offsetof(Padded, flag))
+      .Sequence<uint32_t>("values", ts_introspection::ROS_TYPE_UINT32, offsetof(Padded, values));
+
+  const uint32_t values[] = {7, 8, 9};
+  const uint64_t count = 3;
+  //aligned layout: layout marker, flag, padding up to size alignment, size, values (already aligned)
+  alignas(8) char aligned[8 + 8 + sizeof(count) + sizeof(values)] = {};
+  std::memcpy(aligned, eCAL::rmw::aligned_layout_marker, eCAL::rmw::layout_marker_size);
+  aligned[8] = 1;
+  std::memcpy(aligned + 16, &count, sizeof(count));
+  std::memcpy(aligned + 24, values, sizeof(values));
+  MessageView aligned_view{padded.TypeSupport(), aligned, sizeof(aligned), WireLayout::aligned};
+  auto array = aligned_view.GetArray<uint32_t>("values");
+  ASSERT_EQ(3u, array.size());
+  EXPECT_EQ(9u, array[2]);
+
+  //packed layout: values directly follow flag and size
+  alignas(8) char packed[1 + sizeof(count) + sizeof(values)] = {};
+  packed[0] = 1;
+  std::memcpy(packed + 1, &count, sizeof(count));
+  std::memcpy(packed + 9, values, sizeof(values));
+  MessageView packed_view{padded.TypeSupport(), packed, sizeof(packed), WireLayout::packed};
+  EXPECT_EQ(1u, packed_view.Get<uint8_t>("flag"));
+  //elements start at odd offset, so they can't be viewed in place
+  EXPECT_THROW(packed_view.GetArray<uint32_t>("values"), std::runtime_error);
+
+  //messages of publishers using the other layout are rejected
+  EXPECT_THROW((MessageView{padded.TypeSupport(), aligned, sizeof(aligned), WireLayout::packed}), std::runtime_error);
+  EXPECT_THROW((MessageView{padded.TypeSupport(), packed, sizeof(packed), WireLayout::aligned}), std::runtime_error);
+}
+
+TEST(MessageView, InvalidRequests)
+{
+  auto cloud = test_msgs::MakePointCloud2();
+  auto serialized = Serialize(Types().point_cloud2, cloud);
+  auto view = View(Types().point_cloud2, serialized);
+
+  EXPECT_THROW(view.Get<uint32_t>("missing"), std::invalid_argument);
+  EXPECT_THROW(view.Get<uint64_t>("height"), std::invalid_argument);
+  EXPECT_THROW(view.Get<uint64_t>("header.frame_id"), std::invalid_argument);
+  EXPECT_THROW(view.Get<uint64_t>("header"), std::invalid_argument);
+  EXPECT_THROW(view.Get<uint32_t>("fields.offset"), std::invalid_argument);
+  EXPECT_THROW(view.GetArray<uint8_t>("height"), std::invalid_argument);
+  EXPECT_THROW(view.GetArray<uint64_t>("fields"), std::invalid_argument);
+}
+
+TEST(MessageView, TruncatedMessage)
+{
+  auto cloud = test_msgs::MakePointCloud2();
+  auto serialized = Serialize(Types().point_cloud2, cloud);
+  MessageView view{Types().point_cloud2.TypeSupport(), serialized.data(), serialized.size() - 1, eCAL::rmw::GetWireLayout()};
+
+  EXPECT_EQ(cloud.width, view.Get<uint32_t>("width"));
+  EXPECT_THROW(view.Get<bool>("is_dense"), std::out_of_range);
+}
+
+//Array size taken from the message must not wrap around when multiplied by element size.
+TEST(MessageView, HugeArraySize)
+{
+  struct Values
+  {
+    std::vector<int64_t> values;
+    int32_t after;
+  };
+  MessageDescription description{"Values", sizeof(Values)};
+  description.Sequence<int64_t>("values", ts_introspection::ROS_TYPE_INT64, offsetof(Values, values))
+      .Value("after", ts_introspection::ROS_TYPE_INT32, offsetof(Values, after));
+
+  Values message{{}, 42};
+  auto serialized = Serialize(description, message);
+  //size is the first field behind layout header in both layouts, 2^61 * 8 wraps around to 0
+  const uint64_t huge = 1ull << 61;
+  std::memcpy(&serialized[eCAL::rmw::LayoutHeaderSize(eCAL::rmw::GetWireLayout())], &huge, sizeof(huge));
+
+  auto view = View(description, serialized);
+  EXPECT_THROW(view.Get<int32_t>("after"), std::out_of_range);
+  EXPECT_THROW(view.GetArray<int64_t>("values"), std::out_of_range);
+}
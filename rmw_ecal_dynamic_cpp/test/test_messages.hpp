@@ -0,0 +1,545 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+#include <rosidl_typesupport_introspection_cpp/identifier.hpp>
+#include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
+
+//Hand written introspection of messages shaped like the high bandwidth standard types
+//(sensor_msgs, nav_msgs, tf2_msgs), so serialization tests don't need generated code.
+namespace test_msgs
+{
+  namespace ts_introspection = rosidl_typesupport_introspection_cpp;
+
+  struct Time
+  {
+    int32_t sec;
+    uint32_t nanosec;
+  };
+
+  struct Header
+  {
+    Time stamp;
+    std::string frame_id;
+  };
+
+  struct Vector3
+  {
+    double x;
+    double y;
+    double z;
+  };
+
+  struct Quaternion
+  {
+    double x;
+    double y;
+    double z;
+    double w;
+  };
+
+  struct Pose
+  {
+    Vector3 position;
+    Quaternion orientation;
+  };
+
+  struct PoseWithCovariance
+  {
+    Pose pose;
+    double covariance[36];
+  };
+
+  struct Twist
+  {
+    Vector3 linear;
+    Vector3 angular;
+  };
+
+  struct TwistWithCovariance
+  {
+    Twist twist;
+    double covariance[36];
+  };
+
+  struct Image
+  {
+    Header header;
+    uint32_t height;
+    uint32_t width;
+    std::string encoding;
+    uint8_t is_bigendian;
+    uint32_t step;
+    std::vector<uint8_t> data;
+  };
+
+  struct CompressedImage
+  {
+    Header header;
+    std::string format;
+    std::vector<uint8_t> data;
+  };
+
+  struct PointField
+  {
+    std::string name;
+    uint32_t offset;
+    uint8_t datatype;
+    uint32_t count;
+  };
+
+  struct PointCloud2
+  {
+    Header header;
+    uint32_t height;
+    uint32_t width;
+    std::vector<PointField> fields;
+    bool is_bigendian;
+    uint32_t point_step;
+    uint32_t row_step;
+    std::vector<uint8_t> data;
+    bool is_dense;
+  };
+
+  struct LaserScan
+  {
+    Header header;
+    float angle_min;
+    float angle_max;
+    float angle_increment;
+    float time_increment;
+    float scan_time;
+    float range_min;
+    float range_max;
+    std::vector<float> ranges;
+    std::vector<float> intensities;
+  };
+
+  struct Imu
+  {
+    Header header;
+    Quaternion orientation;
+    double orientation_covariance[9];
+    Vector3 angular_velocity;
+    double angular_velocity_covariance[9];
+    Vector3 linear_acceleration;
+    double linear_acceleration_covariance[9];
+  };
+
+  struct TransformStamped
+  {
+    Header header;
+    std::string child_frame_id;
+    Vector3 translation;
+    Quaternion rotation;
+  };
+
+  struct TFMessage
+  {
+    std::vector<TransformStamped> transforms;
+  };
+
+  struct Odometry
+  {
+    Header header;
+    std::string child_frame_id;
+    PoseWithCovariance pose;
+    TwistWithCovariance twist;
+  };
+
+  //Everything the standard types above don't use.
+  struct Misc
+  {
+    bool flag;
+    std::vector<bool> flags;
+    std::vector<std::string> names;
+    std::string labels[3];
+    int16_t small[5];
+    std::vector<int64_t> large;
+    std::vector<Header> headers;
+    Header fixed_headers[2];
+    std::vector<double> bounded;
+  };
+
+  //Builds introspection of a single message type. Instances have to outlive everything
+  //which uses their members and must not get more members once they are used.
+  class MessageDescription
+  {
+    std::vector<ts_introspection::MessageMember> members_;
+    ts_introspection::MessageMembers message_members_;
+    rosidl_message_type_support_t type_support_;
+
+    static const rosidl_message_type_support_t *GetHandle(const rosidl_message_type_support_t *handle, const char *identifier)
+    {
+      return std::strcmp(handle->typesupport_identifier, identifier) == 0 ? handle : nullptr;
+    }
+
+    template <typename T>
+    static size_t Size(const void *array)
+    {
+      return static_cast<const std::vector<T> *>(array)->size();
+    }
+
+    template <typename T>
+    static const void *GetConst(const void *array, size_t index)
+    {
+      return &(*static_cast<const std::vector<T> *>(array))[index];
+    }
+
+    template <typename T>
+    static void *Get(void *array, size_t index)
+    {
+      return &(*static_cast<std::vector<T> *>(array))[index];
+    }
+
+    template <typename T>
+    static void Resize(void *array, size_t size)
+    {
+      static_cast<std::vector<T> *>(array)->resize(size);
+    }
+
+    ts_introspection::MessageMember &Add(const char *name, uint8_t type_id, size_t offset)
+    {
+      ts_introspection::MessageMember member{};
+      member.name_ = name;
+      member.type_id_ = type_id;
+      member.offset_ = static_cast<uint32_t>(offset);
+      members_.push_back(member);
+      message_members_.member_count_ = static_cast<uint32_t>(members_.size());
+      message_members_.members_ = members_.data();
+      return members_.back();
+    }
+
+  public:
+    MessageDescription(const char *name, size_t size_of)
+        : message_members_{}, type_support_{}
+    {
+      message_members_.message_namespace_ = "test_msgs::msg";
+      message_members_.message_name_ = name;
+      message_members_.size_of_ = size_of;
+      type_support_.typesupport_identifier = ts_introspection::typesupport_identifier;
+      type_support_.data = &message_members_;
+      type_support_.func = GetHandle;
+    }
+
+    MessageDescription(const MessageDescription &) = delete;
+    MessageDescription &operator=(const MessageDescription &) = delete;
+
+    MessageDescription &Value(const char *name, uint8_t type_id, size_t offset)
+    {
+      Add(name, type_id, offset);
+      return *this;
+    }
+
+    MessageDescription &BoundedString(const char *name, size_t offset, size_t upper_bound)
+    {
+      Add(name, ts_introspection::ROS_TYPE_STRING, offset).string_upper_bound_ = upper_bound;
+      return *this;
+    }
+
+    MessageDescription &Array(const char *name, uint8_t type_id, size_t offset, size_t size)
+    {
+      auto &member = Add(name, type_id, offset);
+      member.is_array_ = true;
+      member.array_size_ = size;
+      return *this;
+    }
+
+    template <typename T>
+    MessageDescription &Sequence(const char *name, uint8_t type_id, size_t offset, size_t upper_bound = 0)
+    {
+      auto &member = Add(name, type_id, offset);
+      member.is_array_ = true;
+      member.array_size_ = upper_bound;
+      member.is_upper_bound_ = upper_bound > 0;
+      member.size_function = Size<T>;
+      member.get_const_function = GetConst<T>;
+      member.get_function = Get<T>;
+      member.resize_function = Resize<T>;
+      return *this;
+    }
+
+    MessageDescription &Message(const char *name, const MessageDescription &type, size_t offset)
+    {
+      Add(name, ts_introspection::ROS_TYPE_MESSAGE, offset).members_ = type.TypeSupport();
+      return *this;
+    }
+
+    MessageDescription &MessageArray(const char *name, const MessageDescription &type, size_t offset, size_t size)
+    {
+      auto &member = Add(name, ts_introspection::ROS_TYPE_MESSAGE, offset);
+      member.members_ = type.TypeSupport();
+      member.is_array_ = true;
+      member.array_size_ = size;
+      return *this;
+    }
+
+    template <typename T>
+    MessageDescription &MessageSequence(const char *name, const MessageDescription &type, size_t offset)
+    {
+      Sequence<T>(name, ts_introspection::ROS_TYPE_MESSAGE, offset).members_.back().members_ = type.TypeSupport();
+      return *this;
+    }
+
+    const ts_introspection::MessageMembers *Members() const
+    {
+      return &message_members_;
+    }
+
+    const rosidl_message_type_support_t *TypeSupport() const
+    {
+      return &type_support_;
+    }
+  };
+
+  //std::vector<bool> has no addressable elements.
+  template <>
+  inline const void *MessageDescription::GetConst<bool>(const void *, size_t)
+  {
+    return nullptr;
+  }
+
+  template <>
+  inline void *MessageDescription::Get<bool>(void *, size_t)
+  {
+    return nullptr;
+  }
+
+  struct Descriptions
+  {
+    MessageDescription time{"Time", sizeof(Time)};
+    MessageDescription header{"Header", sizeof(Header)};
+    MessageDescription vector3{"Vector3", sizeof(Vector3)};
+    MessageDescription quaternion{"Quaternion", sizeof(Quaternion)};
+    MessageDescription pose{"Pose", sizeof(Pose)};
+    MessageDescription pose_with_covariance{"PoseWithCovariance", sizeof(PoseWithCovariance)};
+    MessageDescription twist{"Twist", sizeof(Twist)};
+    MessageDescription twist_with_covariance{"TwistWithCovariance", sizeof(TwistWithCovariance)};
+    MessageDescription image{"Image", sizeof(Image)};
+    MessageDescription compressed_image{"CompressedImage", sizeof(CompressedImage)};
+    MessageDescription point_field{"PointField", sizeof(PointField)};
+    MessageDescription point_cloud2{"PointCloud2", sizeof(PointCloud2)};
+    MessageDescription laser_scan{"LaserScan", sizeof(LaserScan)};
+    MessageDescription imu{"Imu", sizeof(Imu)};
+    MessageDescription transform_stamped{"TransformStamped", sizeof(TransformStamped)};
+    MessageDescription tf_message{"TFMessage", sizeof(TFMessage)};
+    MessageDescription odometry{"Odometry", sizeof(Odometry)};
+    MessageDescription misc{"Misc", sizeof(Misc)};
+
+    Descriptions()
+    {
+      time.Value("sec", ts_introspection::ROS_TYPE_INT32, offsetof(Time, sec))
+          .Value("nanosec", ts_introspection::ROS_TYPE_UINT32, offsetof(Time, nanosec));
+      header.Message("stamp", time, offsetof(Header, stamp))
+          .Value("frame_id", ts_introspection::ROS_TYPE_STRING, offsetof(Header, frame_id));
+      vector3.Value("x", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Vector3, x))
+          .Value("y", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Vector3, y))
+          .Value("z", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Vector3, z));
+      quaternion.Value("x", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Quaternion, x))
+          .Value("y", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Quaternion, y))
+          .Value("z", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Quaternion, z))
+          .Value("w", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Quaternion, w));
+      pose.Message("position", vector3, offsetof(Pose, position))
+          .Message("orientation", quaternion, offsetof(Pose, orientation));
+      pose_with_covariance.Message("pose", pose, offsetof(PoseWithCovariance, pose))
+          .Array("covariance", ts_introspection::ROS_TYPE_DOUBLE, offsetof(PoseWithCovariance, covariance), 36);
+      twist.Message("linear", vector3, offsetof(Twist, linear))
+          .Message("angular", vector3, offsetof(Twist, angular));
+      twist_with_covariance.Message("twist", twist, offsetof(TwistWithCovariance, twist))
+          .Array("covariance", ts_introspection::ROS_TYPE_DOUBLE, offsetof(TwistWithCovariance, covariance), 36);
+
+      image.Message("header", header, offsetof(Image, header))
+          .Value("height", ts_introspection::ROS_TYPE_UINT32, offsetof(Image, height))
+          .Value("width", ts_introspection::ROS_TYPE_UINT32, offsetof(Image, width))
+          .Value("encoding", ts_introspection::ROS_TYPE_STRING, offsetof(Image, encoding))
+          .Value("is_bigendian", ts_introspection::ROS_TYPE_UINT8, offsetof(Image, is_bigendian))
+          .Value("step", ts_introspection::ROS_TYPE_UINT32, offsetof(Image, step))
+          .Sequence<uint8_t>("data", ts_introspection::ROS_TYPE_UINT8, offsetof(Image, data));
+      compressed_image.Message("header", header, offsetof(CompressedImage, header))
+          .Value("format", ts_introspection::ROS_TYPE_STRING, offsetof(CompressedImage, format))
+          .Sequence<uint8_t>("data", ts_introspection::ROS_TYPE_UINT8, offsetof(CompressedImage, data));
+      point_field.Value("name", ts_introspection::ROS_TYPE_STRING, offsetof(PointField, name))
+          .Value("offset", ts_introspection::ROS_TYPE_UINT32, offsetof(PointField, offset))
+          .Value("datatype", ts_introspection::ROS_TYPE_UINT8, offsetof(PointField, datatype))
+          .Value("count", ts_introspection::ROS_TYPE_UINT32, offsetof(PointField, count));
+      point_cloud2.Message("header", header, offsetof(PointCloud2, header))
+          .Value("height", ts_introspection::ROS_TYPE_UINT32, offsetof(PointCloud2, height))
+          .Value("width", ts_introspection::ROS_TYPE_UINT32, offsetof(PointCloud2, width))
+          .MessageSequence<PointField>("fields", point_field, offsetof(PointCloud2, fields))
+          .Value("is_bigendian", ts_introspection::ROS_TYPE_BOOLEAN, offsetof(PointCloud2, is_bigendian))
+          .Value("point_step", ts_introspection::ROS_TYPE_UINT32, offsetof(PointCloud2, point_step))
+          .Value("row_step", ts_introspection::ROS_TYPE_UINT32, offsetof(PointCloud2, row_step))
+          .Sequence<uint8_t>("data", ts_introspection::ROS_TYPE_UINT8, offsetof(PointCloud2, data))
+          .Value("is_dense", ts_introspection::ROS_TYPE_BOOLEAN, offsetof(PointCloud2, is_dense));
+      laser_scan.Message("header", header, offsetof(LaserScan, header))
+          .Value("angle_min", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, angle_min))
+          .Value("angle_max", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, angle_max))
+          .Value("angle_increment", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, angle_increment))
+          .Value("time_increment", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, time_increment))
+          .Value("scan_time", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, scan_time))
+          .Value("range_min", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, range_min))
+          .Value("range_max", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, range_max))
+          .Sequence<float>("ranges", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, ranges))
+          .Sequence<float>("intensities", ts_introspection::ROS_TYPE_FLOAT, offsetof(LaserScan, intensities));
+      imu.Message("header", header, offsetof(Imu, header))
+          .Message("orientation", quaternion, offsetof(Imu, orientation))
+          .Array("orientation_covariance", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Imu, orientation_covariance), 9)
+          .Message("angular_velocity", vector3, offsetof(Imu, angular_velocity))
+          .Array("angular_velocity_covariance", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Imu, angular_velocity_covariance), 9)
+          .Message("linear_acceleration", vector3, offsetof(Imu, linear_acceleration))
+          .Array("linear_acceleration_covariance", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Imu, linear_acceleration_covariance), 9);
+      transform_stamped.Message("header", header, offsetof(TransformStamped, header))
+          .Value("child_frame_id", ts_introspection::ROS_TYPE_STRING, offsetof(TransformStamped, child_frame_id))
+          .Message("translation", vector3, offsetof(TransformStamped, translation))
+          .Message("rotation", quaternion, offsetof(TransformStamped, rotation));
+      tf_message.MessageSequence<TransformStamped>("transforms", transform_stamped, offsetof(TFMessage, transforms));
+      odometry.Message("header", header, offsetof(Odometry, header))
+          .Value("child_frame_id", ts_introspection::ROS_TYPE_STRING, offsetof(Odometry, child_frame_id))
+          .Message("pose", pose_with_covariance, offsetof(Odometry, pose))
+          .Message("twist", twist_with_covariance, offsetof(Odometry, twist));
+      misc.Value("flag", ts_introspection::ROS_TYPE_BOOLEAN, offsetof(Misc, flag))
+          .Sequence<bool>("flags", ts_introspection::ROS_TYPE_BOOLEAN, offsetof(Misc, flags))
+          .Sequence<std::string>("names", ts_introspection::ROS_TYPE_STRING, offsetof(Misc, names))
+          .Array("labels", ts_introspection::ROS_TYPE_STRING, offsetof(Misc, labels), 3)
+          .Array("small", ts_introspection::ROS_TYPE_INT16, offsetof(Misc, small), 5)
+          .Sequence<int64_t>("large", ts_introspection::ROS_TYPE_INT64, offsetof(Misc, large))
+          .MessageSequence<Header>("headers", header, offsetof(Misc, headers))
+          .MessageArray("fixed_headers", header, offsetof(Misc, fixed_headers), 2)
+          .Sequence<double>("bounded", ts_introspection::ROS_TYPE_DOUBLE, offsetof(Misc, bounded), 16);
+    }
+  };
+
+  inline const Descriptions &GetDescriptions()
+  {
+    static const Descriptions descriptions;
+    return descriptions;
+  }
+
+  inline Header MakeHeader(int32_t sec, const std::string &frame_id)
+  {
+    return Header{Time{sec, 500u}, frame_id};
+  }
+
+  inline Image MakeImage()
+  {
+    Image image{MakeHeader(1, "camera"), 48, 64, "rgb8", 0, 64 * 3, {}};
+    image.data.resize(image.height * image.step);
+    for (size_t i = 0; i < image.data.size(); i++)
+    {
+      image.data[i] = static_cast<uint8_t>(i * 31);
+    }
+    return image;
+  }
+
+  inline CompressedImage MakeCompressedImage()
+  {
+    return CompressedImage{MakeHeader(2, "camera"), "jpeg", std::vector<uint8_t>(333, 0xAB)};
+  }
+
+  inline PointCloud2 MakePointCloud2()
+  {
+    PointCloud2 cloud{};
+    cloud.header = MakeHeader(3, "lidar");
+    cloud.height = 1;
+    cloud.width = 100;
+    cloud.fields = {{"x", 0, 7, 1}, {"y", 4, 7, 1}, {"z", 8, 7, 1}, {"intensity", 12, 7, 1}};
+    cloud.point_step = 16;
+    cloud.row_step = cloud.point_step * cloud.width;
+    cloud.data.assign(cloud.row_step, 0x5A);
+    cloud.is_dense = true;
+    return cloud;
+  }
+
+  inline LaserScan MakeLaserScan()
+  {
+    LaserScan scan{MakeHeader(4, "laser"), -1.5f, 1.5f, 0.01f, 0.0f, 0.1f, 0.2f, 30.0f, {}, {}};
+    for (int i = 0; i < 300; i++)
+    {
+      scan.ranges.push_back(i * 0.1f);
+      scan.intensities.push_back(i * 2.0f);
+    }
+    return scan;
+  }
+
+  inline Imu MakeImu()
+  {
+    Imu imu{};
+    imu.header = MakeHeader(5, "imu");
+    imu.orientation = {0.1, 0.2, 0.3, 0.9};
+    imu.angular_velocity = {1.0, 2.0, 3.0};
+    imu.linear_acceleration = {0.0, 0.0, 9.81};
+    for (int i = 0; i < 9; i++)
+    {
+      imu.orientation_covariance[i] = i;
+      imu.angular_velocity_covariance[i] = i * 2;
+      imu.linear_acceleration_covariance[i] = i * 3;
+    }
+    return imu;
+  }
+
+  inline TFMessage MakeTFMessage()
+  {
+    TFMessage tf;
+    tf.transforms.push_back({MakeHeader(6, "map"), "odom", {1.0, 2.0, 3.0}, {0.0, 0.0, 0.0, 1.0}});
+    tf.transforms.push_back({MakeHeader(7, "odom"), "base_link", {4.0, 5.0, 6.0}, {0.0, 0.0, 1.0, 0.0}});
+    return tf;
+  }
+
+  inline Odometry MakeOdometry()
+  {
+    Odometry odometry{};
+    odometry.header = MakeHeader(8, "odom");
+    odometry.child_frame_id = "base_link";
+    odometry.pose.pose = {{1.0, 2.0, 3.0}, {0.0, 0.0, 0.0, 1.0}};
+    odometry.twist.twist = {{0.5, 0.0, 0.0}, {0.0, 0.0, 0.1}};
+    for (int i = 0; i < 36; i++)
+    {
+      odometry.pose.covariance[i] = i;
+      odometry.twist.covariance[i] = -i;
+    }
+    return odometry;
+  }
+
+  inline Misc MakeMisc()
+  {
+    Misc misc{};
+    misc.flag = true;
+    //length not divisible by word size to cover bulk conversion tail
+    for (int i = 0; i < 1003; i++)
+    {
+      misc.flags.push_back(i % 3 == 0);
+    }
+    misc.names = {"", "a", std::string(100, 'n'), "last"};
+    misc.labels[0] = "first";
+    misc.labels[2] = "third";
+    for (int i = 0; i < 5; i++)
+    {
+      misc.small[i] = static_cast<int16_t>(-i);
+    }
+    misc.large = {1, -2, 1ll << 40};
+    misc.headers = {MakeHeader(9, "a"), MakeHeader(10, "")};
+    misc.fixed_headers[0] = MakeHeader(11, "fixed");
+    misc.fixed_headers[1] = MakeHeader(12, "headers");
+    misc.bounded = {0.5, 1.5};
+    return misc;
+  }
+} // namespace test_msgs
@@ -0,0 +1,150 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "serialization/type_info.hpp"
+#include "serialization/wire_layout.hpp"
+
+#include "test_messages.hpp"
+
+namespace
+{
+  namespace ts_introspection = rosidl_typesupport_introspection_cpp;
+  using eCAL::rmw::TypeInfo::GetLayout;
+} // namespace
+
+TEST(TypeInfo, MemcopyableMessage)
+{
+  const auto &layout = GetLayout(test_msgs::GetDescriptions().time.Members());
+  EXPECT_TRUE(layout.memcopyable);
+  EXPECT_TRUE(layout.fixed_size);
+  EXPECT_TRUE(layout.bounded);
+  EXPECT_EQ(sizeof(test_msgs::Time), layout.serialized_size);
+  EXPECT_EQ(sizeof(test_msgs::Time), layout.max_serialized_size);
+}
+
+TEST(TypeInfo, MessageWithString)
+{
+  const auto &layout = GetLayout(test_msgs::GetDescriptions().header.Members());
+  EXPECT_FALSE(layout.memcopyable);
+  EXPECT_FALSE(layout.fixed_size);
+  EXPECT_FALSE(layout.bounded);
+  //stamp and empty frame_id
+  EXPECT_EQ(sizeof(test_msgs::Time) + sizeof(array_size_t), layout.serialized_size);
+}
+
+TEST(TypeInfo, PodRuns)
+{
+  const auto &layout = GetLayout(test_msgs::GetDescriptions().laser_scan.Members());
+  ASSERT_EQ(10u, layout.pod_runs.size());
+  //header on its own, seven floats in one block, sequences on their own
+  EXPECT_EQ(1u, layout.pod_runs[0].member_count);
+  EXPECT_EQ(7u, layout.pod_runs[1].member_count);
+  EXPECT_EQ(7 * sizeof(float), layout.pod_runs[1].size);
+  EXPECT_EQ(1u, layout.pod_runs[8].member_count);
+  EXPECT_EQ(1u, layout.pod_runs[9].member_count);
+}
+
+TEST(TypeInfo, BoundedMessage)
+{
+  struct Bounded
+  {
+    std::string name;
+    std::vector<int32_t> values;
+  };
+  test_msgs::MessageDescription bounded{"Bounded", sizeof(Bounded)};
+  bounded.BoundedString("name", offsetof(Bounded, name), 10)
+      .Sequence<int32_t>("values", ts_introspection::ROS_TYPE_INT32, offsetof(Bounded, values), 4);
+
+  const auto &layout = GetLayout(bounded.Members());
+  EXPECT_TRUE(layout.bounded);
+  size_t expected = sizeof(array_size_t) + 10 + sizeof(array_size_t) + 4 * sizeof(int32_t);
+  if (eCAL::rmw::GetWireLayout() == eCAL::rmw::WireLayout::aligned)
+  {
+    //worst case padding in front of sequence size and elements
+    expected += alignof(array_size_t) - 1 + sizeof(int32_t) - 1;
+  }
+  EXPECT_EQ(expected, layout.max_serialized_size);
+}
+
+TEST(TypeInfo, LookupReturnsRegisteredLayout)
+{
+  auto members = test_msgs::GetDescriptions().odometry.Members();
+  const auto &first = GetLayout(members);
+  EXPECT_EQ(&first, &GetLayout(members));
+}
+
+//Threads register distinct types and look up shared ones at the same time,
+//every thread has to see a single layout per type.
+TEST(TypeInfo, ConcurrentRegistration)
+{
+  const int thread_count = 8;
+  const int types_per_thread = 50;
+
+  std::vector<std::unique_ptr<test_msgs::MessageDescription>> descriptions;
+  for (int i = 0; i < thread_count * types_per_thread; i++)
+  {
+    descriptions.emplace_back(new test_msgs::MessageDescription{"Generated", sizeof(test_msgs::Header)});
+    descriptions.back()->Message("stamp", test_msgs::GetDescriptions().time, offsetof(test_msgs::Header, stamp))
+        .Value("frame_id", ts_introspection::ROS_TYPE_STRING, offsetof(test_msgs::Header, frame_id));
+  }
+
+  std::vector<std::vector<const eCAL::rmw::TypeInfo::TypeLayout *>> seen(thread_count);
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; t++)
+  {
+    threads.emplace_back([&, t] {
+      while (!start)
+      {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < types_per_thread; i++)
+      {
+        //every thread touches all types, starting at a different one
+        for (int j = 0; j < thread_count; j++)
+        {
+          auto index = ((t + j) % thread_count) * types_per_thread + i;
+          seen[t].push_back(&GetLayout(descriptions[index]->Members()));
+        }
+      }
+    });
+  }
+  start = true;
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (int t = 0; t < thread_count; t++)
+  {
+    size_t k = 0;
+    for (int i = 0; i < types_per_thread; i++)
+    {
+      for (int j = 0; j < thread_count; j++, k++)
+      {
+        auto index = ((t + j) % thread_count) * types_per_thread + i;
+        ASSERT_EQ(&GetLayout(descriptions[index]->Members()), seen[t][k]);
+        EXPECT_FALSE(seen[t][k]->memcopyable);
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "rmw_ecal_dynamic_cpp/message_view.hpp"
+
+#include "serialization/serializer_cpp.hpp"
+#include "serialization/deserializer_cpp.hpp"
+#include "serialization/compiled_codec_cpp.hpp"
+#include "serialization/wire_layout.hpp"
+
+#include "test_messages.hpp"
+
+namespace
+{
+  using eCAL::rmw::WireLayout;
+  using test_msgs::MessageDescription;
+
+  const WireLayout layouts[] = {WireLayout::packed, WireLayout::aligned};
+
+  WireLayout Other(WireLayout layout)
+  {
+    return layout == WireLayout::packed ? WireLayout::aligned : WireLayout::packed;
+  }
+
+  //Every deserializer reads messages written in its own layout and rejects those of processes using the other one.
+  template <typename T>
+  void ExpectLayoutChecked(const MessageDescription &description, const T &message)
+  {
+    auto members = description.Members();
+    for (auto writer_layout : layouts)
+    {
+      eCAL::rmw::CppSerializer generic_serializer{members, writer_layout};
+      eCAL::rmw::CompiledCppSerializer compiled_serializer{members, writer_layout};
+      const auto serialized = generic_serializer.Serialize(&message);
+      EXPECT_EQ(serialized, compiled_serializer.Serialize(&message));
+      EXPECT_TRUE(eCAL::rmw::MatchesLayout(writer_layout, serialized.data(), serialized.size()));
+      EXPECT_FALSE(eCAL::rmw::MatchesLayout(Other(writer_layout), serialized.data(), serialized.size()));
+
+      eCAL::rmw::CppDeserializer generic_deserializer{members, writer_layout};
+      eCAL::rmw::CompiledCppDeserializer compiled_deserializer{members, writer_layout};
+      T generic_result{};
+      generic_deserializer.Deserialize(&generic_result, serialized.data(), serialized.size());
+      EXPECT_EQ(serialized, generic_serializer.Serialize(&generic_result));
+      T compiled_result{};
+      compiled_deserializer.Deserialize(&compiled_result, serialized.data(), serialized.size());
+      EXPECT_EQ(serialized, generic_serializer.Serialize(&compiled_result));
+
+      eCAL::rmw::CppDeserializer other_generic_deserializer{members, Other(writer_layout)};
+      eCAL::rmw::CompiledCppDeserializer other_compiled_deserializer{members, Other(writer_layout)};
+      T rejected{};
+      EXPECT_THROW(other_generic_deserializer.Deserialize(&rejected, serialized.data(), serialized.size()), std::runtime_error);
+      EXPECT_THROW(other_compiled_deserializer.Deserialize(&rejected, serialized.data(), serialized.size()), std::runtime_error);
+      EXPECT_THROW((eCAL::rmw::MessageView{description.TypeSupport(), serialized.data(), serialized.size(), Other(writer_layout)}),
+                   std::runtime_error);
+    }
+  }
+
+  const test_msgs::Descriptions &Types()
+  {
+    return test_msgs::GetDescriptions();
+  }
+} // namespace
+
+TEST(WireLayout, Image)
+{
+  ExpectLayoutChecked(Types().image, test_msgs::MakeImage());
+}
+
+TEST(WireLayout, PointCloud2)
+{
+  ExpectLayoutChecked(Types().point_cloud2, test_msgs::MakePointCloud2());
+}
+
+TEST(WireLayout, Imu)
+{
+  ExpectLayoutChecked(Types().imu, test_msgs::MakeImu());
+}
+
+TEST(WireLayout, Odometry)
+{
+  //memcopyable message, serialized as single block behind layout header
+  ExpectLayoutChecked(Types().odometry, test_msgs::MakeOdometry());
+}
+
+TEST(WireLayout, Misc)
+{
+  ExpectLayoutChecked(Types().misc, test_msgs::MakeMisc());
+}
+
+TEST(WireLayout, EmptyBufferIsPacked)
+{
+  EXPECT_TRUE(eCAL::rmw::MatchesLayout(WireLayout::packed, "", 0));
+  EXPECT_FALSE(eCAL::rmw::MatchesLayout(WireLayout::aligned, "", 0));
+}
@@ -40,6 +40,13 @@ namespace eCAL
         return serialized_message;
       }
 
+      //Protobuf clears output string before serializing into it, so capacity of reused buffer is kept.
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data) override
+      {
+        serialized_data.Clear();
+        typesupport_->serialize(data, serialized_data.Buffer());
+      }
+
       virtual const std::string GetMessageStringDescriptor() const override
       {
         return typesupport_->get_descriptor();
@@ -64,6 +64,13 @@ namespace eCAL
         return serialized_data;
       }
 
+      //Protobuf clears output string before serializing into it, so capacity of reused buffer is kept.
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data) override
+      {
+        serialized_data.Clear();
+        type_support_->serialize(data, serialized_data.Buffer());
+      }
+
       virtual void Deserialize(void *message, const void *serialized_data, size_t size) override
       {
         type_support_->deserialize(message, serialized_data, size);
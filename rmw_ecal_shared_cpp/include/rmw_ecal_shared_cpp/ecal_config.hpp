@@ -0,0 +1,78 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    //eCAL configuration of a single process, carried by rmw_init_options_t::impl->ecal_config and
+    //passed to eCAL::Initialize by rmw_init. Values override those read from ecal.ini.
+    //
+    //It is filled from environment when init options are initialized:
+    //  RMW_ECAL_INI_FILE     alternative ecal.ini used by this process
+    //  RMW_ECAL_CONFIG_FILE  YAML file with ecal.ini sections as mappings, e.g.
+    //                          publisher:
+    //                            use_shm: 2
+    //                            memfile_buf_count: 3
+    //                          topic_layers:
+    //                            /points: shm
+    //                            /camera/*: shm
+    //  RMW_ECAL_CONFIG       inline values "section/key=value;section/key=value"
+    //and can be adjusted afterwards by application through init options.
+    struct EcalConfig
+    {
+      std::string ini_file;
+      //"section/key" -> value, e.g. "publisher/use_shm" -> "2"
+      std::map<std::string, std::string> values;
+      //topic name pattern ('*' matches any characters) -> transport layer of publishers
+      //(shm, udp, tcp, inproc or auto), first matching pattern wins
+      std::vector<std::pair<std::string, std::string>> topic_layers;
+
+      void Set(const std::string &key, const std::string &value)
+      {
+        values[key] = value;
+      }
+
+      void Set(const std::string &key, const char *value)
+      {
+        values[key] = value;
+      }
+
+      void Set(const std::string &key, bool value)
+      {
+        values[key] = value ? "true" : "false";
+      }
+
+      template <typename T>
+      void Set(const std::string &key, T value)
+      {
+        values[key] = std::to_string(value);
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
+
+//Implementation specific part of rmw_init_options_t (rmw_init_options_t::impl).
+struct rmw_init_options_impl_s
+{
+  eCAL::rmw::EcalConfig ecal_config;
+};
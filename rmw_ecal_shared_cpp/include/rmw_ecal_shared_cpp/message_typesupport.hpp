@@ -16,6 +16,8 @@
 
 #include <string>
 
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
 namespace eCAL
 {
   namespace rmw
@@ -29,7 +31,22 @@ namespace eCAL
       virtual const std::string GetMessageName() const = 0;
       virtual size_t GetTypeSize() const = 0;
       virtual const std::string Serialize(const void *data) = 0;
+
+      //Large arrays may be referenced from message instead of being copied,
+      //implementations which don't support it serialize into single buffer.
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data)
+      {
+        serialized_data.Assign(Serialize(data));
+      }
+
       virtual void Deserialize(void *message, const void *serialized_data, size_t size) = 0;
+
+      //Messages of publishers which serialize differently (e.g. other wire layout) are dropped when received.
+      virtual bool CanDeserialize(const void * /* serialized_data */, size_t /* size */) const
+      {
+        return true;
+      }
+
       virtual std::string GetTypeDescriptor() const = 0;
     };
 
@@ -84,7 +84,9 @@ namespace eCAL
                                              rmw_publisher_allocation_t *allocation);
 
     RMW_PROTOBUF_SHARED_CPP_PUBLIC
-    rmw_ret_t rmw_get_serialized_message_size(const char *implementation_identifier, const rosidl_message_type_support_t *type_support,
+    rmw_ret_t rmw_get_serialized_message_size(const char *implementation_identifier,
+                                              const SerializerFactory &ecal_serializer_factory,
+                                              const rosidl_message_type_support_t *type_support,
                                               const rosidl_runtime_c__Sequence__bound *message_bounds,
                                               size_t *size);
 
@@ -0,0 +1,196 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cstring>
+#include <cstddef>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    //Serialized message split into segments (iovec like).
+    //Small fields are copied into internal buffer, while large arrays which are at least
+    //reference_threshold bytes long are only referenced, so they have to outlive this object.
+    //Default threshold disables referencing, which results in single contiguous buffer.
+    class SerializedSegments
+    {
+    public:
+      struct Segment
+      {
+        const char *data;
+        size_t size;
+      };
+
+    private:
+      //external segments point to referenced data, internal ones to range of buffer_
+      struct SegmentInfo
+      {
+        const char *external_data;
+        size_t offset;
+        size_t size;
+      };
+
+      std::string buffer_;
+      std::vector<SegmentInfo> segments_;
+      size_t buffer_flushed_ = 0;
+      size_t external_size_ = 0;
+      size_t reference_threshold_;
+
+      void FlushBuffer()
+      {
+        if (buffer_.size() > buffer_flushed_)
+        {
+          segments_.push_back(SegmentInfo{nullptr, buffer_flushed_, buffer_.size() - buffer_flushed_});
+          buffer_flushed_ = buffer_.size();
+        }
+      }
+
+    public:
+      explicit SerializedSegments(size_t reference_threshold = std::numeric_limits<size_t>::max())
+          : reference_threshold_(reference_threshold)
+      {
+      }
+
+      //Returns true if data of given size would be referenced instead of copied.
+      bool IsReferenced(size_t size) const
+      {
+        return size >= reference_threshold_;
+      }
+
+      void Reserve(size_t size)
+      {
+        buffer_.reserve(buffer_.size() + size);
+      }
+
+      void Append(const char *data, size_t size)
+      {
+        buffer_.append(data, size);
+      }
+
+      void Append(size_t count, char value)
+      {
+        buffer_.append(count, value);
+      }
+
+      template <typename InputIt>
+      void Append(InputIt first, InputIt last)
+      {
+        buffer_.append(first, last);
+      }
+
+      //Appends size bytes and returns pointer to them, which is valid until next append.
+      char *Extend(size_t size)
+      {
+        auto offset = buffer_.size();
+        buffer_.resize(offset + size);
+        return &buffer_[offset];
+      }
+
+      //Appends data which is stored in message itself, large blocks are referenced in place.
+      void AppendReferenced(const char *data, size_t size)
+      {
+        if (!IsReferenced(size))
+        {
+          Append(data, size);
+          return;
+        }
+        FlushBuffer();
+        segments_.push_back(SegmentInfo{data, 0, size});
+        external_size_ += size;
+      }
+
+      //Replaces content with already serialized contiguous message.
+      void Assign(std::string buffer)
+      {
+        buffer_ = std::move(buffer);
+        segments_.clear();
+        buffer_flushed_ = 0;
+        external_size_ = 0;
+      }
+
+      //Removes content, but keeps allocated capacity for next message.
+      void Clear()
+      {
+        buffer_.clear();
+        segments_.clear();
+        buffer_flushed_ = 0;
+        external_size_ = 0;
+      }
+
+      //Total size of serialized message.
+      size_t Size() const
+      {
+        return buffer_.size() + external_size_;
+      }
+
+      bool IsContiguous() const
+      {
+        return external_size_ == 0;
+      }
+
+      //Buffer holding whole message, valid only if message is contiguous.
+      std::string &Buffer()
+      {
+        return buffer_;
+      }
+
+      std::vector<Segment> GetSegments() const
+      {
+        std::vector<Segment> segments;
+        segments.reserve(segments_.size() + 1);
+        for (const auto &segment : segments_)
+        {
+          auto data = segment.external_data != nullptr ? segment.external_data : buffer_.data() + segment.offset;
+          segments.push_back(Segment{data, segment.size});
+        }
+        if (buffer_.size() > buffer_flushed_)
+        {
+          segments.push_back(Segment{buffer_.data() + buffer_flushed_, buffer_.size() - buffer_flushed_});
+        }
+        return segments;
+      }
+
+      //Calls func(const char *data, size_t size) for every segment in order.
+      template <typename Func>
+      void ForEachSegment(Func func) const
+      {
+        for (const auto &segment : segments_)
+        {
+          func(segment.external_data != nullptr ? segment.external_data : buffer_.data() + segment.offset, segment.size);
+        }
+        if (buffer_.size() > buffer_flushed_)
+        {
+          func(buffer_.data() + buffer_flushed_, buffer_.size() - buffer_flushed_);
+        }
+      }
+
+      //Copies all segments into destination, which has to be at least Size() bytes long.
+      void CopyTo(void *destination) const
+      {
+        auto dest = static_cast<char *>(destination);
+        ForEachSegment([&dest](const char *data, size_t size) {
+          std::memcpy(dest, data, size);
+          dest += size;
+        });
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
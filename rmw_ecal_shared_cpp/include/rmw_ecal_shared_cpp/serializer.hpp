@@ -16,6 +16,8 @@
 
 #include <string>
 
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
 namespace eCAL
 {
   namespace rmw
@@ -25,6 +27,14 @@ namespace eCAL
     public:
       virtual ~Serializer() = default;
       virtual const std::string Serialize(const void *data) = 0;
+
+      //Large arrays may be referenced from message instead of being copied,
+      //implementations which don't support it serialize into single buffer.
+      virtual void SerializeSegments(const void *data, SerializedSegments &serialized_data)
+      {
+        serialized_data.Assign(Serialize(data));
+      }
+
       virtual const std::string GetMessageStringDescriptor() const = 0;
     };
 
@@ -29,6 +29,13 @@ namespace eCAL
     public:
       virtual Serializer *CreateSerializer(const rosidl_message_type_support_t *type_support) const = 0;
       virtual Deserializer *CreateDeserializer(const rosidl_message_type_support_t *type_support) const = 0;
+
+      //Stores upper bound of serialized size of given type into size, returns false
+      //if messages of this type are unbounded or the bound is not known.
+      virtual bool GetSerializedSizeBound(const rosidl_message_type_support_t * /* type_support */, size_t * /* size */) const
+      {
+        return false;
+      }
     };
 
   } // namespace rmw
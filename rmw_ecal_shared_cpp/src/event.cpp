@@ -14,6 +14,12 @@
 
 #include "rmw_ecal_shared_cpp/rmw/event.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include <rmw/events_statuses/events_statuses.h>
+
 #include "internal/common.hpp"
 #include "internal/publisher.hpp"
 #include "internal/subscriber.hpp"
@@ -22,6 +28,21 @@ namespace eCAL
 {
   namespace rmw
   {
+    namespace
+    {
+      int32_t ToStatusCount(uint64_t count)
+      {
+        return static_cast<int32_t>(std::min<uint64_t>(count, std::numeric_limits<int32_t>::max()));
+      }
+
+      template <typename Status>
+      void FillCountStatus(uint64_t total_count, uint64_t total_count_change, void *event_info)
+      {
+        auto status = static_cast<Status *>(event_info);
+        status->total_count = ToStatusCount(total_count);
+        status->total_count_change = ToStatusCount(total_count_change);
+      }
+    } // namespace
 
     rmw_ret_t rmw_publisher_event_init(const char *implementation_identifier,
                                        rmw_event_t *rmw_event,
@@ -32,14 +53,21 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, publisher);
 
-      if (event_type != rmw_event_type_t::RMW_EVENT_OFFERED_DEADLINE_MISSED)
+      auto ecal_pub = GetImplementation(publisher);
+      switch (event_type)
       {
+      case rmw_event_type_t::RMW_EVENT_OFFERED_DEADLINE_MISSED:
+        rmw_event->data = &ecal_pub->GetDeadlineMissedEventListener();
+        break;
+      case rmw_event_type_t::RMW_EVENT_LIVELINESS_LOST:
+        rmw_event->data = &ecal_pub->GetLivelinessLostEventListener();
+        break;
+      default:
         return RMW_RET_UNSUPPORTED;
       }
 
       rmw_event->event_type = event_type;
       rmw_event->implementation_identifier = implementation_identifier;
-      rmw_event->data = &GetImplementation(publisher)->GetDataDroppedEventListener();
 
       return RMW_RET_OK;
     }
@@ -53,21 +81,35 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, subscription);
 
-      if (event_type != rmw_event_type_t::RMW_EVENT_REQUESTED_DEADLINE_MISSED)
+      auto ecal_sub = GetImplementation(subscription);
+      switch (event_type)
       {
+      case rmw_event_type_t::RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+        rmw_event->data = &ecal_sub->GetDeadlineMissedEventListener();
+        break;
+      case rmw_event_type_t::RMW_EVENT_LIVELINESS_CHANGED:
+        ecal_sub->TrackLiveliness();
+        //rmw_take_event casts it back from Event
+        rmw_event->data = static_cast<Event *>(&ecal_sub->GetLivelinessChangedEventListener());
+        break;
+#if ROS_DISTRO >= GALACTIC
+      case rmw_event_type_t::RMW_EVENT_MESSAGE_LOST:
+        rmw_event->data = &ecal_sub->GetMessageLostEventListener();
+        break;
+#endif
+      default:
         return RMW_RET_UNSUPPORTED;
       }
 
       rmw_event->event_type = event_type;
       rmw_event->implementation_identifier = implementation_identifier;
-      rmw_event->data = &GetImplementation(subscription)->GetDataDroppedEventListener();
 
       return RMW_RET_OK;
     }
 
     rmw_ret_t rmw_take_event(const char *implementation_identifier,
                              const rmw_event_t *event_handle,
-                             void * /* event_info */,
+                             void *event_info,
                              bool *taken)
     {
       RMW_CHECK_ARGUMENT_FOR_NULL(event_handle, RMW_RET_INVALID_ARGUMENT);
@@ -75,7 +117,44 @@ namespace eCAL
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, event_handle);
 
       auto ecal_event = GetImplementation(event_handle);
-      *taken = ecal_event->TakeTriggered();
+      uint64_t total_count = 0;
+      uint64_t total_count_change = 0;
+      *taken = ecal_event->Take(total_count, total_count_change);
+      if (!*taken || event_info == nullptr)
+      {
+        return RMW_RET_OK;
+      }
+
+      switch (event_handle->event_type)
+      {
+      case rmw_event_type_t::RMW_EVENT_OFFERED_DEADLINE_MISSED:
+        FillCountStatus<rmw_offered_deadline_missed_status_t>(total_count, total_count_change, event_info);
+        break;
+      case rmw_event_type_t::RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+        FillCountStatus<rmw_requested_deadline_missed_status_t>(total_count, total_count_change, event_info);
+        break;
+      case rmw_event_type_t::RMW_EVENT_LIVELINESS_LOST:
+        FillCountStatus<rmw_liveliness_lost_status_t>(total_count, total_count_change, event_info);
+        break;
+      case rmw_event_type_t::RMW_EVENT_LIVELINESS_CHANGED:
+      {
+        auto status = static_cast<rmw_liveliness_changed_status_t *>(event_info);
+        static_cast<LivelinessChangedEvent *>(ecal_event)->TakeStatus(status->alive_count, status->not_alive_count,
+                                                                      status->alive_count_change, status->not_alive_count_change);
+      }
+      break;
+#if ROS_DISTRO >= GALACTIC
+      case rmw_event_type_t::RMW_EVENT_MESSAGE_LOST:
+      {
+        auto status = static_cast<rmw_message_lost_status_t *>(event_info);
+        status->total_count = static_cast<size_t>(total_count);
+        status->total_count_change = static_cast<size_t>(total_count_change);
+      }
+      break;
+#endif
+      default:
+        break;
+      }
 
       return RMW_RET_OK;
     }
@@ -85,9 +164,10 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(event, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, event);
 
+      //event is owned by its publisher or subscription
       event->event_type = rmw_event_type_t::RMW_EVENT_INVALID;
       event->implementation_identifier = nullptr;
-      delete GetImplementation(event);
+      event->data = nullptr;
 
       return RMW_RET_OK;
     }
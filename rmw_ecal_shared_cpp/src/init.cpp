@@ -14,12 +14,20 @@
 
 #include "rmw_ecal_shared_cpp/rmw/init.hpp"
 
+#include <string>
+#include <vector>
+#include <exception>
+
 #include <rmw/error_handling.h>
 #include <rmw/impl/cpp/macros.hpp>
 
 #include <ecal/ecal.h>
 
 #include "internal/common.hpp"
+#include "internal/registration.hpp"
+#include "internal/ecal_config_loader.hpp"
+#include "internal/topic_layers.hpp"
+#include "internal/shm_buffering.hpp"
 
 namespace eCAL
 {
@@ -31,15 +39,28 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(options, RMW_RET_INVALID_ARGUMENT);
       RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
 
-      int status = eCAL::Initialize(0, nullptr, nullptr, eCAL::Init::Default | eCAL::Init::Monitoring);
+      const auto config = options->impl != nullptr ? options->impl->ecal_config : EcalConfig{};
+      try
+      {
+        TopicLayerRules::Instance().SetRules(config.topic_layers);
+      }
+      catch (const std::exception &e)
+      {
+        RMW_SET_ERROR_MSG(e.what());
+        return RMW_RET_INVALID_ARGUMENT;
+      }
+
+      auto args = EcalConfigLoader::ToInitializeArguments(config);
+      int status = eCAL::Initialize(args, nullptr, eCAL::Init::Default | eCAL::Init::Monitoring);
       if (status == -1)
         return RMW_RET_ERROR;
 
+      //native eCAL publishers and subscribers of this process have to reach each other,
+      //subscribers drop loopback samples of rmw publishers which delivered them through IntraProcess
       eCAL::Util::EnableLoopback(true);
-      eCAL::Process::SetState(eCAL_Process_eSeverity::proc_sev_healthy,
-                              eCAL_Process_eSeverity_Level::proc_sev_level1,
-                              "Initializing");
-      eCAL::Process::SleepMS(1000);
+      //graph queries wait for registrations of other processes, publishing and subscribing don't have to
+      Registration::OnInitialized();
+      ShmBuffering::OnInitialized(config);
       eCAL::Process::SetState(eCAL_Process_eSeverity::proc_sev_healthy,
                               eCAL_Process_eSeverity_Level::proc_sev_level1,
                               "Running");
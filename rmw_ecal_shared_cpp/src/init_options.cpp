@@ -14,9 +14,14 @@
 
 #include "rmw_ecal_shared_cpp/rmw/init_options.hpp"
 
+#include <new>
+
 #include <rmw/impl/cpp/macros.hpp>
 
+#include <rmw_ecal_shared_cpp/ecal_config.hpp>
+
 #include "internal/common.hpp"
+#include "internal/ecal_config_loader.hpp"
 
 namespace eCAL
 {
@@ -27,10 +32,21 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(init_options, RMW_RET_INVALID_ARGUMENT);
       RCUTILS_CHECK_ALLOCATOR(&allocator, return RMW_RET_INVALID_ARGUMENT);
 
+      rmw_init_options_impl_t *impl = nullptr;
+      try
+      {
+        impl = new rmw_init_options_impl_t{EcalConfigLoader::LoadFromEnvironment()};
+      }
+      catch (const std::bad_alloc &)
+      {
+        RMW_SET_ERROR_MSG("failed to allocate init options");
+        return RMW_RET_BAD_ALLOC;
+      }
+
       init_options->instance_id = 0;
       init_options->implementation_identifier = implementation_identifier;
       init_options->allocator = allocator;
-      init_options->impl = nullptr;
+      init_options->impl = impl;
 
       return RMW_RET_OK;
     }
@@ -40,8 +56,28 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(src, RMW_RET_INVALID_ARGUMENT);
       RMW_CHECK_ARGUMENT_FOR_NULL(dst, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, src);
+      if (dst->implementation_identifier != nullptr)
+      {
+        RMW_SET_ERROR_MSG("expected zero-initialized dst");
+        return RMW_RET_INVALID_ARGUMENT;
+      }
+
+      rmw_init_options_impl_t *impl = nullptr;
+      if (src->impl != nullptr)
+      {
+        try
+        {
+          impl = new rmw_init_options_impl_t(*src->impl);
+        }
+        catch (const std::bad_alloc &)
+        {
+          RMW_SET_ERROR_MSG("failed to allocate init options");
+          return RMW_RET_BAD_ALLOC;
+        }
+      }
 
       *dst = *src;
+      dst->impl = impl;
 
       return RMW_RET_OK;
     }
@@ -52,6 +88,7 @@ namespace eCAL
       RCUTILS_CHECK_ALLOCATOR(&(init_options->allocator), return RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, init_options);
 
+      delete init_options->impl;
       *init_options = ::rmw_get_zero_initialized_init_options();
 
       return RMW_RET_OK;
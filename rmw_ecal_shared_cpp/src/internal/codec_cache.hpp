@@ -0,0 +1,107 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#include <rmw_ecal_shared_cpp/serializer.hpp>
+#include <rmw_ecal_shared_cpp/deserializer.hpp>
+#include <rmw_ecal_shared_cpp/serializer_factory.hpp>
+#include <rmw_ecal_shared_cpp/serialized_segments.hpp>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    //Serializers/deserializers used by rmw_serialize/rmw_deserialize, created once per factory type and type support.
+    //Rmw implementations loaded into the same process share this cache and pass temporary factories, so factories
+    //are told apart by their type. Codecs keep per call state, so uses of one serializer and of one deserializer are
+    //serialized by their own mutex.
+    //Entries are never removed, type support libraries therefore have to stay loaded while their types are serialized.
+    //Library unloaded and loaded again (as rosbag2 does on demand) at the same address reuses entries of its types,
+    //which is only valid for the very same library.
+    class CodecCache
+    {
+      //arrays at least this large are copied straight from message into destination buffer
+      static constexpr size_t reference_threshold = 4 * 1024;
+
+      struct Entry
+      {
+        std::mutex serializer_mutex;
+        std::unique_ptr<Serializer> serializer;
+        //reused between calls, so steady state serialization doesn't allocate
+        SerializedSegments serialized_data{reference_threshold};
+        std::mutex deserializer_mutex;
+        std::unique_ptr<Deserializer> deserializer;
+      };
+
+      using Key = std::pair<std::type_index, const rosidl_message_type_support_t *>;
+
+      std::mutex entries_mutex_;
+      std::map<Key, std::unique_ptr<Entry>> entries_;
+
+      Entry &GetEntry(const SerializerFactory &factory, const rosidl_message_type_support_t *type_support)
+      {
+        std::lock_guard<std::mutex> lock(entries_mutex_);
+        auto &entry = entries_[Key{std::type_index{typeid(factory)}, type_support}];
+        if (!entry)
+        {
+          entry.reset(new Entry{});
+        }
+        return *entry;
+      }
+
+    public:
+      template <typename Func>
+      void WithSerializer(const SerializerFactory &factory, const rosidl_message_type_support_t *type_support, Func func)
+      {
+        auto &entry = GetEntry(factory, type_support);
+        std::lock_guard<std::mutex> lock(entry.serializer_mutex);
+        if (!entry.serializer)
+        {
+          entry.serializer.reset(factory.CreateSerializer(type_support));
+        }
+        entry.serialized_data.Clear();
+        func(*entry.serializer, entry.serialized_data);
+      }
+
+      template <typename Func>
+      void WithDeserializer(const SerializerFactory &factory, const rosidl_message_type_support_t *type_support, Func func)
+      {
+        auto &entry = GetEntry(factory, type_support);
+        std::lock_guard<std::mutex> lock(entry.deserializer_mutex);
+        if (!entry.deserializer)
+        {
+          entry.deserializer.reset(factory.CreateDeserializer(type_support));
+        }
+        func(*entry.deserializer);
+      }
+
+      static CodecCache &Instance()
+      {
+        static CodecCache cache;
+        return cache;
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,301 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "internal/event.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Process wide hierarchical timer wheel checking deadlines of all publishers and subscribers
+    //from single thread. Activity only stores timestamp, entries are moved in the wheel lazily
+    //when their slot expires, so rearming on every message is O(1) and lock-free.
+    class DeadlineTimer
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+
+      struct Entry
+      {
+        std::atomic<long long> last_activity_ms;
+        long long period_ms;
+        Event *missed_event;
+        //set when owner is destroyed, entry is deleted by wheel
+        bool cancelled;
+      };
+
+    private:
+      //1 ms ticks, level 0 covers 256 ms, every following level 64 times more (up to ~18 h)
+      static constexpr int levels = 4;
+      static constexpr uint64_t level0_bits = 8;
+      static constexpr uint64_t level_bits = 6;
+
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      std::thread thread_;
+      bool running_ = false;
+      size_t entry_count_ = 0;
+      Clock::time_point start_ = Clock::now();
+      uint64_t current_tick_ = 0;
+      std::array<std::vector<std::vector<Entry *>>, levels> wheel_;
+
+      static uint64_t Shift(int level)
+      {
+        return level == 0 ? 0 : level0_bits + (level - 1) * level_bits;
+      }
+
+      static uint64_t SlotCount(int level)
+      {
+        return level == 0 ? uint64_t{1} << level0_bits : uint64_t{1} << level_bits;
+      }
+
+      void Insert(Entry *entry, uint64_t expiry_tick)
+      {
+        //only cascading entries can be due already, they go to slot which is expired next
+        if (expiry_tick < current_tick_)
+        {
+          expiry_tick = current_tick_;
+        }
+        for (int level = 0; level < levels; level++)
+        {
+          auto shift = Shift(level);
+          auto slots = SlotCount(level);
+          if ((expiry_tick >> shift) - (current_tick_ >> shift) < slots || level == levels - 1)
+          {
+            //anything beyond last level is clamped, it's checked again when its slot expires
+            if ((expiry_tick >> shift) - (current_tick_ >> shift) >= slots)
+            {
+              expiry_tick = ((current_tick_ >> shift) + slots - 1) << shift;
+            }
+            wheel_[level][(expiry_tick >> shift) & (slots - 1)].push_back(entry);
+            return;
+          }
+        }
+      }
+
+      void Cascade(int level)
+      {
+        auto &slot = wheel_[level][(current_tick_ >> Shift(level)) & (SlotCount(level) - 1)];
+        std::vector<Entry *> entries;
+        entries.swap(slot);
+        for (auto entry : entries)
+        {
+          Insert(entry, Expiry(entry));
+        }
+      }
+
+      uint64_t Expiry(const Entry *entry) const
+      {
+        auto last_activity = entry->last_activity_ms.load(std::memory_order_relaxed);
+        return static_cast<uint64_t>(std::max<long long>(last_activity + entry->period_ms, 0));
+      }
+
+      void Expire(Entry *entry)
+      {
+        if (entry->cancelled)
+        {
+          delete entry;
+          entry_count_--;
+          return;
+        }
+        auto expiry = Expiry(entry);
+        if (expiry > current_tick_)
+        {
+          Insert(entry, expiry);
+          return;
+        }
+        //period elapsed without activity, next miss is reported one period later
+        entry->missed_event->Trigger();
+        entry->last_activity_ms.store(static_cast<long long>(current_tick_), std::memory_order_relaxed);
+        Insert(entry, current_tick_ + entry->period_ms);
+      }
+
+      void Advance(uint64_t to_tick)
+      {
+        while (current_tick_ < to_tick)
+        {
+          current_tick_++;
+          //higher levels first, so their entries reach lower level slots before those are cascaded
+          int cascade_level = 0;
+          while (cascade_level + 1 < levels && (current_tick_ & ((uint64_t{1} << Shift(cascade_level + 1)) - 1)) == 0)
+          {
+            cascade_level++;
+          }
+          for (int level = cascade_level; level > 0; level--)
+          {
+            Cascade(level);
+          }
+          auto &slot = wheel_[0][current_tick_ & (SlotCount(0) - 1)];
+          if (slot.empty())
+          {
+            continue;
+          }
+          std::vector<Entry *> entries;
+          entries.swap(slot);
+          for (auto entry : entries)
+          {
+            Expire(entry);
+          }
+        }
+      }
+
+      //Ticks until next non-empty level 0 slot or next cascade.
+      uint64_t TicksToNextWork() const
+      {
+        auto level0_slots = SlotCount(0);
+        for (uint64_t ticks = 1; ticks <= level0_slots; ticks++)
+        {
+          auto tick = current_tick_ + ticks;
+          if (!wheel_[0][tick & (level0_slots - 1)].empty() || (tick & (level0_slots - 1)) == 0)
+          {
+            return ticks;
+          }
+        }
+        return level0_slots;
+      }
+
+      void Run()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+          if (entry_count_ == 0)
+          {
+            condition_.wait(lock);
+            continue;
+          }
+          auto wake_up = start_ + std::chrono::milliseconds(current_tick_ + TicksToNextWork());
+          condition_.wait_until(lock, wake_up);
+          Advance(Now());
+        }
+      }
+
+      DeadlineTimer()
+      {
+        for (int level = 0; level < levels; level++)
+        {
+          wheel_[level].resize(SlotCount(level));
+        }
+      }
+
+    public:
+      ~DeadlineTimer()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          running_ = false;
+        }
+        condition_.notify_all();
+        if (thread_.joinable())
+        {
+          thread_.join();
+        }
+        for (auto &level : wheel_)
+        {
+          for (auto &slot : level)
+          {
+            for (auto entry : slot)
+            {
+              delete entry;
+            }
+          }
+        }
+      }
+
+      static DeadlineTimer &Instance()
+      {
+        static DeadlineTimer timer;
+        return timer;
+      }
+
+      uint64_t Now() const
+      {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count());
+      }
+
+      Entry *Add(long long period_ms, Event *missed_event)
+      {
+        auto entry = new Entry{};
+        entry->period_ms = std::max<long long>(period_ms, 1);
+        entry->missed_event = missed_event;
+        entry->cancelled = false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        //empty wheel isn't advanced while its thread waits, wheel with entries lags at most one sleep behind
+        if (entry_count_ == 0)
+        {
+          current_tick_ = Now();
+        }
+        else
+        {
+          Advance(Now());
+        }
+        entry->last_activity_ms.store(static_cast<long long>(current_tick_));
+        Insert(entry, Expiry(entry));
+        entry_count_++;
+        if (!running_)
+        {
+          running_ = true;
+          thread_ = std::thread(&DeadlineTimer::Run, this);
+        }
+        condition_.notify_all();
+        return entry;
+      }
+
+      void Remove(Entry *entry)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry->cancelled = true;
+      }
+    };
+
+    //Deadline of single publisher or subscriber, missed_event is triggered once for every period without activity.
+    class Deadline
+    {
+      DeadlineTimer::Entry *entry_;
+
+    public:
+      Deadline(long long period_us, Event &missed_event)
+          : entry_(DeadlineTimer::Instance().Add((period_us + 999) / 1000, &missed_event))
+      {
+      }
+
+      ~Deadline()
+      {
+        DeadlineTimer::Instance().Remove(entry_);
+      }
+
+      Deadline(const Deadline &) = delete;
+      Deadline &operator=(const Deadline &) = delete;
+
+      void Rearm()
+      {
+        entry_->last_activity_ms.store(static_cast<long long>(DeadlineTimer::Instance().Now()), std::memory_order_relaxed);
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
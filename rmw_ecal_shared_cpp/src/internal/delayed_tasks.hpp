@@ -0,0 +1,101 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Single process wide thread running short tasks which must not run in eCAL callbacks.
+    class DelayedTasks
+    {
+      using Clock = std::chrono::steady_clock;
+
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      std::thread thread_;
+      bool running_ = false;
+      std::multimap<Clock::time_point, std::function<void()>> tasks_;
+
+      void Run()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+          if (tasks_.empty())
+          {
+            condition_.wait(lock);
+            continue;
+          }
+          auto next = tasks_.begin();
+          if (next->first > Clock::now())
+          {
+            condition_.wait_until(lock, next->first);
+            continue;
+          }
+          auto task = std::move(next->second);
+          tasks_.erase(next);
+          lock.unlock();
+          task();
+          lock.lock();
+        }
+      }
+
+      DelayedTasks() = default;
+
+    public:
+      ~DelayedTasks()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          running_ = false;
+        }
+        condition_.notify_all();
+        if (thread_.joinable())
+        {
+          thread_.join();
+        }
+      }
+
+      static DelayedTasks &Instance()
+      {
+        static DelayedTasks tasks;
+        return tasks;
+      }
+
+      void Post(std::chrono::milliseconds delay, std::function<void()> task)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.emplace(Clock::now() + delay, std::move(task));
+        if (!running_)
+        {
+          running_ = true;
+          thread_ = std::thread(&DelayedTasks::Run, this);
+        }
+        condition_.notify_all();
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
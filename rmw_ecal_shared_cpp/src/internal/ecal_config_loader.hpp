@@ -0,0 +1,226 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+
+#include <rcutils/logging_macros.h>
+
+#include <rmw_ecal_shared_cpp/ecal_config.hpp>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    namespace EcalConfigLoader
+    {
+      inline std::string Trim(const std::string &value)
+      {
+        auto begin = value.find_first_not_of(" \t\r");
+        if (begin == std::string::npos)
+        {
+          return "";
+        }
+        auto end = value.find_last_not_of(" \t\r");
+        return value.substr(begin, end - begin + 1);
+      }
+
+      inline std::string Unquote(const std::string &value)
+      {
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+        {
+          return value.substr(1, value.size() - 2);
+        }
+        return value;
+      }
+
+      inline std::string StripComment(const std::string &line)
+      {
+        char quote = 0;
+        for (size_t i = 0; i < line.size(); i++)
+        {
+          if (quote != 0)
+          {
+            quote = line[i] == quote ? 0 : quote;
+          }
+          else if (line[i] == '"' || line[i] == '\'')
+          {
+            quote = line[i];
+          }
+          else if (line[i] == '#' && (i == 0 || line[i - 1] == ' ' || line[i - 1] == '\t'))
+          {
+            return line.substr(0, i);
+          }
+        }
+        return line;
+      }
+
+      //Reads subset of YAML matching ecal.ini structure: top level mappings named after
+      //ini sections, each holding scalar values. Top level "ini_file" scalar selects ecal.ini,
+      //"topic_layers" mapping holds transport layer rules of publishers.
+      inline void ParseYaml(std::istream &input, const std::string &file_name, EcalConfig &config)
+      {
+        std::string line;
+        std::string section;
+        size_t line_number = 0;
+        while (std::getline(input, line))
+        {
+          line_number++;
+          line = StripComment(line);
+          auto content = Trim(line);
+          if (content.empty() || content == "---")
+          {
+            continue;
+          }
+
+          auto separator = content.find(':');
+          if (separator == std::string::npos)
+          {
+            throw std::runtime_error(file_name + ":" + std::to_string(line_number) + ": expected 'key: value'.");
+          }
+          auto key = Trim(content.substr(0, separator));
+          auto value = Unquote(Trim(content.substr(separator + 1)));
+          bool indented = line[0] == ' ' || line[0] == '\t';
+
+          if (!indented)
+          {
+            section.clear();
+            if (value.empty())
+            {
+              section = key;
+            }
+            else if (key == "ini_file")
+            {
+              config.ini_file = value;
+            }
+            else
+            {
+              throw std::runtime_error(file_name + ":" + std::to_string(line_number) + ": unknown top level key '" + key + "'.");
+            }
+          }
+          else
+          {
+            if (section.empty())
+            {
+              throw std::runtime_error(file_name + ":" + std::to_string(line_number) + ": value outside of section.");
+            }
+            if (section == "topic_layers")
+            {
+              config.topic_layers.emplace_back(Unquote(key), value);
+            }
+            else
+            {
+              config.values[section + "/" + key] = value;
+            }
+          }
+        }
+      }
+
+      inline void ParseYamlFile(const std::string &file_name, EcalConfig &config)
+      {
+        std::ifstream file{file_name};
+        if (!file)
+        {
+          throw std::runtime_error("Failed to open eCAL config file '" + file_name + "'.");
+        }
+        ParseYaml(file, file_name, config);
+      }
+
+      //Parses "section/key=value;section/key=value".
+      inline void ParseInline(const std::string &values, EcalConfig &config)
+      {
+        size_t begin = 0;
+        while (begin < values.size())
+        {
+          auto end = values.find(';', begin);
+          if (end == std::string::npos)
+          {
+            end = values.size();
+          }
+          auto entry = Trim(values.substr(begin, end - begin));
+          begin = end + 1;
+          if (entry.empty())
+          {
+            continue;
+          }
+          auto separator = entry.find('=');
+          if (separator == std::string::npos || entry.find('/') > separator)
+          {
+            throw std::runtime_error("Invalid eCAL config entry '" + entry + "', expected 'section/key=value'.");
+          }
+          config.values[Trim(entry.substr(0, separator))] = Trim(entry.substr(separator + 1));
+        }
+      }
+
+      //Applies single configuration source. Invalid source is reported and skipped as a whole,
+      //so broken environment doesn't prevent the process from starting with defaults.
+      template <typename Load>
+      inline void TryLoad(const char *variable, EcalConfig &config, Load load)
+      {
+        EcalConfig loaded = config;
+        try
+        {
+          load(loaded);
+          config = std::move(loaded);
+        }
+        catch (const std::exception &e)
+        {
+          RCUTILS_LOG_WARN_NAMED("rmw_ecal", "Ignoring %s: %s", variable, e.what());
+        }
+      }
+
+      inline EcalConfig LoadFromEnvironment()
+      {
+        EcalConfig config;
+        if (auto ini_file = std::getenv("RMW_ECAL_INI_FILE"))
+        {
+          config.ini_file = ini_file;
+        }
+        if (auto config_file = std::getenv("RMW_ECAL_CONFIG_FILE"))
+        {
+          TryLoad("RMW_ECAL_CONFIG_FILE", config, [config_file](EcalConfig &loaded) { ParseYamlFile(config_file, loaded); });
+        }
+        if (auto values = std::getenv("RMW_ECAL_CONFIG"))
+        {
+          TryLoad("RMW_ECAL_CONFIG", config, [values](EcalConfig &loaded) { ParseInline(values, loaded); });
+        }
+        return config;
+      }
+
+      //Command line understood by eCAL::Initialize.
+      inline std::vector<std::string> ToInitializeArguments(const EcalConfig &config)
+      {
+        std::vector<std::string> args{"rmw_ecal"};
+        if (!config.ini_file.empty())
+        {
+          args.push_back("--ecal-ini-file");
+          args.push_back(config.ini_file);
+        }
+        for (const auto &value : config.values)
+        {
+          args.push_back("--set_config_key");
+          args.push_back(value.first + ":" + value.second);
+        }
+        return args;
+      }
+    } // namespace EcalConfigLoader
+  } // namespace rmw
+} // namespace eCAL
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <mutex>
 
 #include <ecal/ecal.h>
@@ -26,47 +27,50 @@ namespace eCAL
   namespace rmw
   {
 
+    //Owned by publisher or subscriber it belongs to, rmw_event_t only references it.
     class Event
     {
       WaitSet *wait_set_ = nullptr;
-      std::atomic_uint8_t triggered_count_;
+      //number of occurrences since creation and how many of them were already taken
+      std::atomic<uint64_t> total_count_;
+      std::atomic<uint64_t> taken_count_;
       std::mutex internal_mutex_;
 
     public:
-      Event() : triggered_count_{0}
+      Event() : total_count_{0}, taken_count_{0}
       {
       }
 
-      void Trigger()
+      void Trigger(uint64_t count = 1)
       {
         std::lock_guard<std::mutex> lock(internal_mutex_);
         if (wait_set_ != nullptr)
         {
           std::unique_lock<std::mutex> clock(wait_set_->condition_mutex);
 
-          triggered_count_++;
+          total_count_ += count;
           clock.unlock();
           wait_set_->Trigger();
         }
         else
         {
-          triggered_count_++;
+          total_count_ += count;
         }
       }
 
       bool Triggered() const
       {
-        return triggered_count_ > 0;
+        return total_count_ > taken_count_;
       }
 
-      bool TakeTriggered()
+      //Takes all occurrences since previous take, returns false if there were none.
+      bool Take(uint64_t &total_count, uint64_t &total_count_change)
       {
-        if (triggered_count_ == 0)
-        {
-          return false;
-        }
-        triggered_count_--;
-        return true;
+        std::lock_guard<std::mutex> lock(internal_mutex_);
+        total_count = total_count_;
+        total_count_change = total_count - taken_count_;
+        taken_count_ = total_count;
+        return total_count_change > 0;
       }
 
       void AttachWaitSet(WaitSet *wait_set)
@@ -0,0 +1,75 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <ecal/ecal.h>
+
+#include <rmw/types.h>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    //eCAL topic id (tid) would identify publishers too, but it's part of registration only and is unique
+    //within its process only, received samples carry nothing but the id set through CPublisher::SetID.
+    //Publisher id is therefore created here and sent with every sample, so subscribers can tell publishers apart.
+    //Upper half identifies the process (host, process id and start time), lower half counts publishers of the process.
+    //0 is reserved by eCAL for "no id".
+    inline uint32_t GetProcessTag()
+    {
+      static const uint32_t process_tag = [] {
+        auto hash = static_cast<uint64_t>(std::hash<std::string>{}(
+            eCAL::Process::GetHostName() + "/" +
+            std::to_string(eCAL::Process::GetProcessID()) + "/" +
+            std::to_string(eCAL::Time::GetNanoSeconds())));
+        auto tag = static_cast<uint32_t>(hash ^ (hash >> 32));
+        return tag != 0 ? tag : 1;
+      }();
+      return process_tag;
+    }
+
+    inline long long CreatePublisherId()
+    {
+      static std::atomic<uint32_t> counter{0};
+      uint32_t index = 0;
+      while (index == 0)
+      {
+        index = ++counter;
+      }
+      return static_cast<long long>((static_cast<uint64_t>(GetProcessTag()) << 32) | index);
+    }
+
+    //True for ids of publishers created by this process.
+    inline bool IsLocalPublisherId(long long publisher_id)
+    {
+      return static_cast<uint32_t>(static_cast<uint64_t>(publisher_id) >> 32) == GetProcessTag();
+    }
+
+    inline void ToGid(long long publisher_id, const char *implementation_identifier, rmw_gid_t *gid)
+    {
+      gid->implementation_identifier = implementation_identifier;
+      std::fill(std::begin(gid->data), std::end(gid->data), uint8_t{0});
+      std::memcpy(gid->data, &publisher_id, sizeof(publisher_id));
+    }
+
+  } // namespace rmw
+} // namespace eCAL
@@ -16,6 +16,7 @@
 
 #include <string>
 #include <list>
+#include <algorithm>
 #include <unordered_set>
 
 #include <ecal/ecal.h>
@@ -34,6 +35,7 @@
 
 #include "internal/qos.hpp"
 #include "internal/node.hpp"
+#include "internal/registration.hpp"
 
 namespace eCAL
 {
@@ -127,7 +129,7 @@ namespace eCAL
 			namespace
 			{
 
-				inline eCAL::rmw::pb::Monitoring GetMonitoringSnapshot()
+				inline eCAL::rmw::pb::Monitoring TakeMonitoringSnapshot()
 				{
 					eCAL::rmw::pb::Monitoring monitoring;
 					std::string monitoring_data;
@@ -137,6 +139,50 @@ namespace eCAL
 					return monitoring;
 				}
 
+				inline bool IsOwnProcessRegistered(const eCAL::rmw::pb::Monitoring &monitoring)
+				{
+					auto host_name = eCAL::Process::GetHostName();
+					auto process_id = eCAL::Process::GetProcessID();
+					auto &processes = monitoring.processes();
+					return std::any_of(processes.begin(), processes.end(), [&](auto &process) {
+						return process.pid() == process_id && process.hname() == host_name;
+					});
+				}
+
+				inline bool IsServiceRegistered(const eCAL::rmw::pb::Monitoring &monitoring, const std::string &service_name)
+				{
+					auto &services = monitoring.services();
+					return std::any_of(services.begin(), services.end(), [&](auto &service) {
+						return service.sname() == service_name;
+					});
+				}
+
+				//Shortly after initialization registrations of other processes might still be missing. Snapshot is
+				//taken as soon as this process received its own registration and no new process appeared since
+				//previous poll, at the latest one registration refresh period after initialization.
+				inline eCAL::rmw::pb::Monitoring GetMonitoringSnapshot()
+				{
+					eCAL::rmw::pb::Monitoring monitoring;
+					int previous_process_count = -1;
+					Registration::WaitUntilReady([&] {
+						monitoring = TakeMonitoringSnapshot();
+						auto process_count = monitoring.processes_size();
+						auto stable = process_count == previous_process_count;
+						previous_process_count = process_count;
+						return stable && IsOwnProcessRegistered(monitoring);
+					});
+
+					return monitoring;
+				}
+
+				//Node info is queried from service of the node, only that service has to be known.
+				inline void WaitForService(const std::string &service_name)
+				{
+					Registration::WaitUntilReady([&] {
+						return IsServiceRegistered(TakeMonitoringSnapshot(), service_name);
+					});
+				}
+
 			} // namespace
 
 			inline Node *CreateNode(const std::string &name_space, const std::string &name)
@@ -183,6 +229,11 @@ namespace eCAL
 
 				for (auto &topic : ecal_topics)
 				{
+					//history replays of transient local publishers are internal
+					if (IsReplayTopicName(topic.tname()))
+					{
+						continue;
+					}
 					if (already_processed_topics.find(topic.tname()) == already_processed_topics.end())
 					{
 						topics.emplace_back(topic.tname(), topic.ttype());
@@ -239,6 +290,7 @@ namespace eCAL
 				eCAL::ServiceResponseVecT response;
 
 				auto service_name = BuildQueryServiceName(node_namespace, node_name);
+				WaitForService(service_name);
 
 				eCAL::CServiceClient client{service_name};
 
@@ -255,6 +307,7 @@ namespace eCAL
 				eCAL::ServiceResponseVecT response;
 
 				auto service_name = BuildQueryServiceName(node_namespace, node_name);
+				WaitForService(service_name);
 
 				eCAL::CServiceClient client{service_name};
 
@@ -271,6 +324,7 @@ namespace eCAL
 				eCAL::ServiceResponseVecT response;
 
 				auto service_name = BuildQueryServiceName(node_namespace, node_name);
+				WaitForService(service_name);
 
 				eCAL::CServiceClient client{service_name};
 
@@ -287,6 +341,7 @@ namespace eCAL
 				eCAL::ServiceResponseVecT response;
 
 				auto service_name = BuildQueryServiceName(node_namespace, node_name);
+				WaitForService(service_name);
 
 				eCAL::CServiceClient client{service_name};
 
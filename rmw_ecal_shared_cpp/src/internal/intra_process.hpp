@@ -0,0 +1,97 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "internal/registration.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    class Subscriber;
+    class SampleHistory;
+
+    //Subscribers of single topic and type living in this process.
+    struct LocalTopic
+    {
+      std::mutex mutex;
+      std::vector<Subscriber *> subscribers;
+      //every subscriber of this process (ignoring local publications too) with its creation time,
+      //eCAL counts them among subscribers of local publishers once their registration arrived
+      std::vector<std::pair<const Subscriber *, std::chrono::steady_clock::time_point>> readers;
+      //ids of publishers delivering to subscribers above, their samples received through eCAL loopback are dropped
+      std::vector<long long> publishers;
+      //publisher id and history of transient local publishers, histories are modified only under mutex
+      std::vector<std::pair<long long, const SampleHistory *>> histories;
+    };
+
+    //Number of readers eCAL surely knows about, registrations of this process are received within a refresh
+    //period, so readers count once two of them passed. Has to be called under topic mutex.
+    inline size_t CountRegisteredReaders(const LocalTopic &topic)
+    {
+      auto registered_before = std::chrono::steady_clock::now() - 2 * Registration::RefreshPeriod();
+      return static_cast<size_t>(std::count_if(topic.readers.begin(), topic.readers.end(),
+                                               [&](const std::pair<const Subscriber *, std::chrono::steady_clock::time_point> &reader) {
+                                                 return reader.second <= registered_before;
+                                               }));
+    }
+
+    //Publishers hand serialized messages directly to subscribers of the same topic and type in the same process.
+    //eCAL loopback stays enabled for native eCAL users and rmw entities with different type names,
+    //subscribers drop loopback samples of publishers which already delivered them directly.
+    //Publishers skip eCAL send while all subscribers known to eCAL are subscribers of this process.
+    class IntraProcess
+    {
+      std::mutex mutex_;
+      std::map<std::pair<std::string, std::string>, std::weak_ptr<LocalTopic>> topics_;
+
+    public:
+      static IntraProcess &Instance()
+      {
+        static IntraProcess intra_process;
+        return intra_process;
+      }
+
+      //Publishers and subscribers keep returned topic alive, it's shared by everyone using the same topic and type.
+      std::shared_ptr<LocalTopic> GetTopic(const std::string &topic_name, const std::string &type_name)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = topics_.begin(); it != topics_.end();)
+        {
+          it = it->second.expired() ? topics_.erase(it) : std::next(it);
+        }
+
+        auto &entry = topics_[std::make_pair(topic_name, type_name)];
+        auto topic = entry.lock();
+        if (!topic)
+        {
+          topic = std::make_shared<LocalTopic>();
+          entry = topic;
+        }
+        return topic;
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,139 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <ecal/ecal.h>
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4146 4800)
+#endif
+#include "ecal/monitoring.pb.h"
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Topic attributes announcing lifespan of rmw publishers, they are sent with eCAL registration.
+    //Samples carry nothing but publisher id, so id is announced too.
+    static const std::string publisher_id_attribute{"publisher_id"};
+    static const std::string lifespan_attribute{"lifespan_us"};
+
+    //Lifespan is publisher policy, subscribers expire messages against lifespan of publisher which sent them.
+    //Publishers of this process register themselves before they send anything, publishers of other processes
+    //are known only after their registration was read from monitoring, which is done on request only.
+    class Lifespans
+    {
+      mutable std::mutex mutex_;
+      std::unordered_map<long long, long long> local_;
+      std::unordered_map<long long, long long> remote_;
+      std::atomic<bool> remote_requested_{false};
+
+    public:
+      static Lifespans &Instance()
+      {
+        static Lifespans lifespans;
+        return lifespans;
+      }
+
+      void AddLocal(long long publisher_id, long long lifespan_us)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        local_[publisher_id] = lifespan_us;
+      }
+
+      void RemoveLocal(long long publisher_id)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        local_.erase(publisher_id);
+      }
+
+      //Replaces publishers of other processes by those of latest monitoring snapshot.
+      void SetRemote(std::unordered_map<long long, long long> &&remote)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remote_ = std::move(remote);
+      }
+
+      //Returns false for unknown publishers, lifespan of 0 means messages never expire.
+      bool Find(long long publisher_id, long long &lifespan_us) const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto local = local_.find(publisher_id);
+        if (local != local_.end())
+        {
+          lifespan_us = local->second;
+          return true;
+        }
+        auto remote = remote_.find(publisher_id);
+        if (remote != remote_.end())
+        {
+          lifespan_us = remote->second;
+          return true;
+        }
+        return false;
+      }
+
+      //Asks for lifespans of other processes to be read from monitoring, returns false if that is already pending.
+      bool Request()
+      {
+        return !remote_requested_.exchange(true, std::memory_order_relaxed);
+      }
+
+      bool IsRequested() const
+      {
+        return remote_requested_.load(std::memory_order_relaxed);
+      }
+
+      //Clears request before monitoring is read, requests arriving meanwhile are served by following scan.
+      bool TakeRequest()
+      {
+        return remote_requested_.exchange(false, std::memory_order_relaxed);
+      }
+    };
+
+    //Lifespans announced by rmw publishers of other processes, native eCAL publishers announce none.
+    inline std::unordered_map<long long, long long> ReadRemoteLifespans(const pb::Monitoring &monitoring, const std::string &host_name, int process_id)
+    {
+      std::unordered_map<long long, long long> lifespans;
+      for (auto &topic : monitoring.topics())
+      {
+        if (topic.direction() != "publisher" || (topic.pid() == process_id && topic.hname() == host_name))
+        {
+          continue;
+        }
+        auto &attributes = topic.attr();
+        auto id = attributes.find(publisher_id_attribute);
+        auto lifespan = attributes.find(lifespan_attribute);
+        if (id == attributes.end() || lifespan == attributes.end())
+        {
+          continue;
+        }
+        lifespans[std::strtoll(id->second.c_str(), nullptr, 10)] = std::strtoll(lifespan->second.c_str(), nullptr, 10);
+      }
+      return lifespans;
+    }
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,525 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ecal/ecal.h>
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4146 4800)
+#endif
+#include "ecal/monitoring.pb.h"
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "internal/event.hpp"
+#include "internal/lifespan.hpp"
+#include "internal/registration.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Topic attributes announcing liveliness of rmw publishers, they are sent with eCAL registration.
+    static const std::string liveliness_kind_attribute{"liveliness"};
+    static const std::string liveliness_lease_attribute{"liveliness_lease_ms"};
+    static const std::string liveliness_asserted_attribute{"liveliness_asserted"};
+    static const std::string liveliness_manual_by_topic{"manual_by_topic"};
+
+    //Shortest time between liveliness scans, leases are checked with this precision at best.
+    constexpr long long min_liveliness_scan_interval_ms = 10;
+
+    //Liveliness changed event keeps counts of alive and not alive publishers besides number of changes.
+    class LivelinessChangedEvent : public Event
+    {
+      std::mutex status_mutex_;
+      int32_t alive_count_ = 0;
+      int32_t not_alive_count_ = 0;
+      int32_t taken_alive_count_ = 0;
+      int32_t taken_not_alive_count_ = 0;
+
+    public:
+      void Update(int32_t alive_count, int32_t not_alive_count)
+      {
+        {
+          std::lock_guard<std::mutex> lock(status_mutex_);
+          if (alive_count == alive_count_ && not_alive_count == not_alive_count_)
+          {
+            return;
+          }
+          alive_count_ = alive_count;
+          not_alive_count_ = not_alive_count;
+        }
+        Trigger();
+      }
+
+      //Returns current counts and their changes since previous take.
+      void TakeStatus(int32_t &alive_count, int32_t &not_alive_count, int32_t &alive_count_change, int32_t &not_alive_count_change)
+      {
+        std::lock_guard<std::mutex> lock(status_mutex_);
+        alive_count = alive_count_;
+        not_alive_count = not_alive_count_;
+        alive_count_change = alive_count_ - taken_alive_count_;
+        not_alive_count_change = not_alive_count_ - taken_not_alive_count_;
+        taken_alive_count_ = alive_count_;
+        taken_not_alive_count_ = not_alive_count_;
+      }
+    };
+
+    //Process wide liveliness check of all publishers and subscribers from single thread.
+    //eCAL registers every topic once per refresh period and monitoring counts registrations in rclock,
+    //so publisher whose rclock didn't change within lease duration belongs to process which stopped.
+    //Manual by topic publishers additionally announce whether they asserted liveliness in time through
+    //topic attribute, no messages besides regular registration are sent. All subscribers are evaluated
+    //from one monitoring snapshot per scan. Lifespans of remote publishers are read from it too when requested.
+    class LivelinessMonitor
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+
+      struct Writer
+      {
+        std::string topic_name;
+        eCAL::CPublisher *publisher;
+        Event *lost_event;
+        bool manual;
+        //0 for infinite lease
+        long long lease_ms;
+        std::atomic<long long> last_assertion_ms;
+        //guarded by monitor mutex
+        bool alive;
+      };
+
+      struct Reader
+      {
+        std::string topic_name;
+        long long lease_ms;
+        bool ignore_local;
+        LivelinessChangedEvent *changed_event;
+      };
+
+    private:
+      struct Heartbeat
+      {
+        int32_t rclock;
+        long long last_change_ms;
+        uint64_t scan;
+      };
+
+      struct RemoteWriter
+      {
+        long long last_heartbeat_ms;
+        long long lease_ms;
+        bool lost;
+      };
+
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      std::thread thread_;
+      bool running_ = false;
+      Clock::time_point start_ = Clock::now();
+      std::vector<std::unique_ptr<Writer>> writers_;
+      std::vector<std::unique_ptr<Reader>> readers_;
+      //remote publishers of topics with local subscribers, keyed by host, process and topic id
+      std::unordered_map<std::string, Heartbeat> heartbeats_;
+      uint64_t scan_count_ = 0;
+      std::string host_name_;
+      int process_id_;
+      //monitors created for tests are scanned explicitly
+      bool background_;
+
+      bool HasWork() const
+      {
+        return !readers_.empty() || Lifespans::Instance().IsRequested() ||
+               std::any_of(writers_.begin(), writers_.end(), [](const std::unique_ptr<Writer> &writer) {
+                 return writer->manual && writer->lease_ms > 0;
+               });
+      }
+
+      long long ScanInterval() const
+      {
+        long long interval = Registration::RefreshPeriod().count();
+        for (auto &writer : writers_)
+        {
+          if (writer->manual && writer->lease_ms > 0)
+          {
+            interval = std::min(interval, writer->lease_ms / 2);
+          }
+        }
+        for (auto &reader : readers_)
+        {
+          if (reader->lease_ms > 0)
+          {
+            interval = std::min(interval, ToHeartbeatLease(reader->lease_ms) / 4);
+          }
+        }
+        return std::max(interval, min_liveliness_scan_interval_ms);
+      }
+
+      void ScanWriters(long long now)
+      {
+        for (auto &writer : writers_)
+        {
+          if (!writer->manual || writer->lease_ms == 0)
+          {
+            continue;
+          }
+          bool alive = now - writer->last_assertion_ms.load(std::memory_order_relaxed) <= writer->lease_ms;
+          if (alive == writer->alive)
+          {
+            continue;
+          }
+          writer->alive = alive;
+          writer->publisher->SetAttribute(liveliness_asserted_attribute, alive ? "1" : "0");
+          if (!alive)
+          {
+            writer->lost_event->Trigger();
+          }
+        }
+      }
+
+      void ScanReaders(const pb::Monitoring &monitoring, long long now)
+      {
+        scan_count_++;
+        std::unordered_map<std::string, std::vector<RemoteWriter>> topics;
+        for (auto &reader : readers_)
+        {
+          topics[reader->topic_name];
+        }
+
+        //publishers of this process are known directly, they might not even be part of monitoring
+        for (auto &topic : monitoring.topics())
+        {
+          if (topic.direction() != "publisher" || (topic.pid() == process_id_ && topic.hname() == host_name_))
+          {
+            continue;
+          }
+          auto found = topics.find(topic.tname());
+          if (found == topics.end())
+          {
+            continue;
+          }
+
+          auto key = topic.hname() + "/" + std::to_string(topic.pid()) + "/" + topic.tid();
+          auto inserted = heartbeats_.emplace(key, Heartbeat{topic.rclock(), now, scan_count_});
+          auto &heartbeat = inserted.first->second;
+          if (heartbeat.rclock != topic.rclock())
+          {
+            heartbeat.rclock = topic.rclock();
+            heartbeat.last_change_ms = now;
+          }
+          heartbeat.scan = scan_count_;
+
+          //publishers without attributes (e.g. native eCAL ones) are automatic with infinite lease
+          auto &attributes = topic.attr();
+          auto lease = attributes.find(liveliness_lease_attribute);
+          auto kind = attributes.find(liveliness_kind_attribute);
+          auto asserted = attributes.find(liveliness_asserted_attribute);
+          bool lost = kind != attributes.end() && kind->second == liveliness_manual_by_topic &&
+                      asserted != attributes.end() && asserted->second == "0";
+          found->second.push_back(RemoteWriter{heartbeat.last_change_ms,
+                                               lease != attributes.end() ? std::strtoll(lease->second.c_str(), nullptr, 10) : 0,
+                                               lost});
+        }
+
+        //publishers which unregistered or whose registration timed out
+        for (auto it = heartbeats_.begin(); it != heartbeats_.end();)
+        {
+          if (it->second.scan != scan_count_)
+          {
+            it = heartbeats_.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+
+        for (auto &reader : readers_)
+        {
+          int32_t alive_count = 0;
+          int32_t not_alive_count = 0;
+          for (auto &writer : topics[reader->topic_name])
+          {
+            auto lease = EffectiveLease(writer.lease_ms, reader->lease_ms);
+            if (!writer.lost && (lease == 0 || now - writer.last_heartbeat_ms <= lease))
+            {
+              alive_count++;
+            }
+            else
+            {
+              not_alive_count++;
+            }
+          }
+          if (!reader->ignore_local)
+          {
+            for (auto &writer : writers_)
+            {
+              if (writer->topic_name != reader->topic_name)
+              {
+                continue;
+              }
+              if (writer->alive)
+              {
+                alive_count++;
+              }
+              else
+              {
+                not_alive_count++;
+              }
+            }
+          }
+          reader->changed_event->Update(alive_count, not_alive_count);
+        }
+      }
+
+      void Run()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+          if (!HasWork())
+          {
+            condition_.wait(lock);
+            continue;
+          }
+          condition_.wait_for(lock, std::chrono::milliseconds(ScanInterval()));
+          if (!running_)
+          {
+            break;
+          }
+
+          //snapshot is taken without lock, so publishers and subscribers can be created meanwhile
+          pb::Monitoring monitoring;
+          bool read_lifespans = Lifespans::Instance().TakeRequest();
+          if (!readers_.empty() || read_lifespans)
+          {
+            lock.unlock();
+            std::string monitoring_data;
+            eCAL::Monitoring::GetMonitoring(monitoring_data);
+            monitoring.ParseFromString(monitoring_data);
+            lock.lock();
+          }
+          auto now = Now();
+          ScanWriters(now);
+          if (!readers_.empty())
+          {
+            ScanReaders(monitoring, now);
+          }
+          if (read_lifespans)
+          {
+            Lifespans::Instance().SetRemote(ReadRemoteLifespans(monitoring, host_name_, process_id_));
+          }
+        }
+      }
+
+      void Start()
+      {
+        if (!running_ && background_)
+        {
+          running_ = true;
+          thread_ = std::thread(&LivelinessMonitor::Run, this);
+        }
+        condition_.notify_all();
+      }
+
+    public:
+      //Process uses Instance(), monitors without background thread are meant for tests.
+      explicit LivelinessMonitor(bool background = true)
+          : host_name_(eCAL::Process::GetHostName()), process_id_(eCAL::Process::GetProcessID()), background_(background)
+      {
+      }
+
+      //Heartbeats arrive once per registration refresh, shorter leases would expire between them.
+      static long long ToHeartbeatLease(long long lease_ms)
+      {
+        if (lease_ms == 0)
+        {
+          return 0;
+        }
+        return std::max<long long>(lease_ms, 2 * Registration::RefreshPeriod().count());
+      }
+
+      static long long EffectiveLease(long long writer_lease_ms, long long reader_lease_ms)
+      {
+        if (writer_lease_ms == 0 || reader_lease_ms == 0)
+        {
+          return ToHeartbeatLease(std::max(writer_lease_ms, reader_lease_ms));
+        }
+        return ToHeartbeatLease(std::min(writer_lease_ms, reader_lease_ms));
+      }
+
+      //Single scan of given monitoring snapshot at given time (see Now), background thread scans fresh snapshots.
+      void Scan(const pb::Monitoring &monitoring, long long now)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ScanWriters(now);
+        if (!readers_.empty())
+        {
+          ScanReaders(monitoring, now);
+        }
+      }
+
+      ~LivelinessMonitor()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          running_ = false;
+        }
+        condition_.notify_all();
+        if (thread_.joinable())
+        {
+          thread_.join();
+        }
+      }
+
+      static LivelinessMonitor &Instance()
+      {
+        static LivelinessMonitor monitor;
+        return monitor;
+      }
+
+      long long Now() const
+      {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+      }
+
+      //Reads lifespans of publishers of other processes with next scan, see Lifespans.
+      void RequestLifespans()
+      {
+        if (Lifespans::Instance().Request())
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          Start();
+        }
+      }
+
+      Writer *AddWriter(const std::string &topic_name, eCAL::CPublisher &publisher, bool manual, long long lease_ms, Event &lost_event)
+      {
+        std::unique_ptr<Writer> writer{new Writer{}};
+        writer->topic_name = topic_name;
+        writer->publisher = &publisher;
+        writer->lost_event = &lost_event;
+        writer->manual = manual;
+        writer->lease_ms = lease_ms;
+        writer->last_assertion_ms.store(Now());
+        writer->alive = true;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        writers_.push_back(std::move(writer));
+        Start();
+        return writers_.back().get();
+      }
+
+      void RemoveWriter(Writer *writer)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writers_.erase(std::remove_if(writers_.begin(), writers_.end(),
+                                      [writer](const std::unique_ptr<Writer> &entry) { return entry.get() == writer; }),
+                       writers_.end());
+      }
+
+      Reader *AddReader(const std::string &topic_name, long long lease_ms, bool ignore_local, LivelinessChangedEvent &changed_event)
+      {
+        std::unique_ptr<Reader> reader{new Reader{topic_name, lease_ms, ignore_local, &changed_event}};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        readers_.push_back(std::move(reader));
+        Start();
+        return readers_.back().get();
+      }
+
+      void RemoveReader(Reader *reader)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readers_.erase(std::remove_if(readers_.begin(), readers_.end(),
+                                      [reader](const std::unique_ptr<Reader> &entry) { return entry.get() == reader; }),
+                       readers_.end());
+      }
+    };
+
+    //Liveliness of single publisher, announces its policy through topic attributes.
+    //Automatic publishers are alive as long as their process registers, manual by topic ones have to publish
+    //or assert liveliness within lease duration, otherwise lost_event is triggered.
+    class PublisherLiveliness
+    {
+      LivelinessMonitor::Writer *writer_;
+
+    public:
+      PublisherLiveliness(eCAL::CPublisher &publisher, bool manual, long long lease_us, Event &lost_event)
+      {
+        auto lease_ms = (lease_us + 999) / 1000;
+        publisher.SetAttribute(liveliness_kind_attribute, manual ? liveliness_manual_by_topic : "automatic");
+        publisher.SetAttribute(liveliness_lease_attribute, std::to_string(lease_ms));
+        if (manual)
+        {
+          publisher.SetAttribute(liveliness_asserted_attribute, "1");
+        }
+        writer_ = LivelinessMonitor::Instance().AddWriter(publisher.GetTopicName(), publisher, manual, lease_ms, lost_event);
+      }
+
+      ~PublisherLiveliness()
+      {
+        LivelinessMonitor::Instance().RemoveWriter(writer_);
+      }
+
+      PublisherLiveliness(const PublisherLiveliness &) = delete;
+      PublisherLiveliness &operator=(const PublisherLiveliness &) = delete;
+
+      void Assert()
+      {
+        if (writer_->manual)
+        {
+          writer_->last_assertion_ms.store(LivelinessMonitor::Instance().Now(), std::memory_order_relaxed);
+        }
+      }
+    };
+
+    //Counts alive and not alive publishers of subscriber's topic, changed_event is triggered when counts change.
+    class SubscriberLiveliness
+    {
+      LivelinessMonitor::Reader *reader_;
+
+    public:
+      SubscriberLiveliness(const std::string &topic_name, long long lease_us, bool ignore_local, LivelinessChangedEvent &changed_event)
+          : reader_(LivelinessMonitor::Instance().AddReader(topic_name, (lease_us + 999) / 1000, ignore_local, changed_event))
+      {
+      }
+
+      ~SubscriberLiveliness()
+      {
+        LivelinessMonitor::Instance().RemoveReader(reader_);
+      }
+
+      SubscriberLiveliness(const SubscriberLiveliness &) = delete;
+      SubscriberLiveliness &operator=(const SubscriberLiveliness &) = delete;
+    };
+
+  } // namespace rmw
+} // namespace eCAL
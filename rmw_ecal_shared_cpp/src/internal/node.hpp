@@ -152,9 +152,10 @@ namespace eCAL
                                          std::bind(&Node::OnGetClients, this, _1, _2, _3, _4, _5));
       }
 
-      Subscriber *CreateSubscriber(const std::string &topic_name, MessageTypeSupport *ts, const SubscriberQOS &qos)
+      Subscriber *CreateSubscriber(const std::string &topic_name, MessageTypeSupport *ts, const SubscriberQOS &qos,
+                                   bool ignore_local_publications = false)
       {
-        auto sub = new Subscriber{topic_name, name_, namespace_, ts, qos};
+        auto sub = new Subscriber{topic_name, name_, namespace_, ts, qos, ignore_local_publications};
         subscribers_.insert(sub);
         return sub;
       }
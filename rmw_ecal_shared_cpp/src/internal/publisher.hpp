@@ -16,58 +16,369 @@
 
 #include <string>
 #include <memory>
+#include <limits>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <utility>
 
 #include <ecal/ecal.h>
+#include <ecal/ecal_time.h>
+
+//payload writer interface and shared memory buffer count of single publisher were introduced in eCAL 5.12
+#if ECAL_VERSION_MAJOR > 5 || (ECAL_VERSION_MAJOR == 5 && ECAL_VERSION_MINOR >= 12)
+#define RMW_ECAL_HAS_PAYLOAD_WRITER
+#define RMW_ECAL_HAS_SHM_BUFFER_COUNT
+#include <ecal/ecal_payload_writer.h>
+#endif
 
 #include <rmw/types.h>
 
 #include "rmw_ecal_shared_cpp/message_typesupport.hpp"
+#include "rmw_ecal_shared_cpp/serialized_segments.hpp"
 
 #include "internal/qos.hpp"
 #include "internal/event.hpp"
+#include "internal/topic_layers.hpp"
+#include "internal/intra_process.hpp"
+#include "internal/subscriber.hpp"
+#include "internal/gid.hpp"
+#include "internal/deadline_timer.hpp"
+#include "internal/sample_history.hpp"
+#include "internal/delayed_tasks.hpp"
+#include "internal/liveliness.hpp"
+#include "internal/lifespan.hpp"
+#include "internal/shm_buffering.hpp"
 
 namespace eCAL
 {
   namespace rmw
   {
+#ifdef RMW_ECAL_HAS_PAYLOAD_WRITER
+    //Writes serialized segments directly into eCAL send buffer (e.g. shared memory file).
+    class SegmentsPayloadWriter : public eCAL::CPayloadWriter
+    {
+      const SerializedSegments &segments_;
+
+    public:
+      explicit SegmentsPayloadWriter(const SerializedSegments &segments) : segments_(segments)
+      {
+      }
+
+      bool WriteFull(void *buffer, size_t size) override
+      {
+        if (size < segments_.Size())
+        {
+          return false;
+        }
+        segments_.CopyTo(buffer);
+        return true;
+      }
+
+      size_t GetSize() override
+      {
+        return segments_.Size();
+      }
+    };
+
+    //Arrays at least this large are written from message memory without intermediate copy.
+    constexpr size_t scatter_gather_threshold = 64 * 1024;
+#else
+    constexpr size_t scatter_gather_threshold = std::numeric_limits<size_t>::max();
+#endif
+
+    //Messages are serialized and sent only while someone subscribes (eCAL recorders included),
+    //RMW_ECAL_PUBLISH_UNSUBSCRIBED=1 sends every message regardless.
+    inline bool PublishUnsubscribed()
+    {
+      static const bool publish_unsubscribed = [] {
+        auto value = std::getenv("RMW_ECAL_PUBLISH_UNSUBSCRIBED");
+        return value != nullptr && std::strcmp(value, "1") == 0;
+      }();
+      return publish_unsubscribed;
+    }
+
+    //eCAL reports new connection before subscriber is added to data writer,
+    //so history is replayed a bit later.
+    constexpr std::chrono::milliseconds history_replay_delay{200};
+    //Replayed history is sent in one go, replay publisher waits this long for shared memory subscribers
+    //to read every message, so messages beyond its buffers don't overwrite those not read yet.
+    constexpr long long replay_shm_acknowledge_timeout_ms = 100;
+
     class Publisher
     {
       std::unique_ptr<MessageTypeSupport> type_support_;
       eCAL::CPublisher publisher_;
       rmw_qos_profile_t ros_qos_profile_;
-      Event data_dropped_event_;
+      Event deadline_missed_event_;
+      //rearmed by every published message, null if QoS has no deadline
+      std::unique_ptr<Deadline> deadline_;
+      Event liveliness_lost_event_;
+      std::unique_ptr<PublisherLiveliness> liveliness_;
+
+      //kept between messages, so its buffers don't have to be reallocated for every message
+      std::mutex publish_mutex_;
+      SerializedSegments serialized_data_{scatter_gather_threshold};
+      std::shared_ptr<LocalTopic> local_topic_;
+      long long id_;
+      //eCAL numbers messages it sends itself, locally delivered messages are numbered here
+      std::atomic<uint64_t> local_sequence_number_{0};
+      //updated from connection events, so publishing doesn't have to query eCAL
+      std::atomic<size_t> subscriber_count_{0};
+
+      //last messages of transient local publisher, null for volatile ones, guarded by local topic mutex
+      std::unique_ptr<SampleHistory> history_;
+      //sends history on replay topic, only transient local subscribers subscribe to it
+      std::unique_ptr<eCAL::CPublisher> replay_publisher_;
+      //lets delayed replays find out whether publisher still exists
+      struct ReplayHandle
+      {
+        std::mutex mutex;
+        Publisher *publisher;
+      };
+      std::shared_ptr<ReplayHandle> replay_handle_;
+
+      void OnConnected(const char * /* topic_name */, const eCAL::SPubEventCallbackData * /* data */)
+      {
+        //connected is reported for first subscriber, which might not be counted yet
+        subscriber_count_ = std::max<size_t>(publisher_.GetSubscriberCount(), 1);
+      }
+
+      void OnConnectionChanged(const char * /* topic_name */, const eCAL::SPubEventCallbackData * /* data */)
+      {
+        subscriber_count_ = publisher_.GetSubscriberCount();
+      }
 
-      void OnDataDropped(const char * /* topic_name */, const eCAL::SPubEventCallbackData * /* data */)
+      void OnReplayConnected(const char * /* topic_name */, const eCAL::SPubEventCallbackData * /* data */)
       {
-        data_dropped_event_.Trigger();
+        std::weak_ptr<ReplayHandle> weak_handle = replay_handle_;
+        DelayedTasks::Instance().Post(history_replay_delay, [weak_handle] {
+          auto handle = weak_handle.lock();
+          if (!handle)
+          {
+            return;
+          }
+          std::lock_guard<std::mutex> lock(handle->mutex);
+          if (handle->publisher != nullptr)
+          {
+            handle->publisher->ReplayHistory();
+          }
+        });
+      }
+
+      //eCAL can't send to single subscriber, history goes to all transient local subscribers and those
+      //which already have the messages drop them. Original send timestamps identify duplicates.
+      //History is copied, so publishing and local delivery don't wait for replay.
+      void ReplayHistory()
+      {
+        std::vector<SampleHistory::Sample> samples;
+        {
+          std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+          samples = history_->Copy();
+        }
+        for (const auto &sample : samples)
+        {
+          replay_publisher_->Send(sample.data.data(), sample.data.size(), sample.send_timestamp);
+        }
+      }
+
+      bool HasLocalSubscribers()
+      {
+        std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+        return !local_topic_->subscribers.empty();
+      }
+
+      bool IsSubscribed()
+      {
+        return PublishUnsubscribed() || subscriber_count_.load(std::memory_order_relaxed) > 0 || HasLocalSubscribers();
+      }
+
+      //Delivers message to subscribers of this process and returns whether eCAL has to send it too,
+      //which is the case while eCAL knows subscribers besides those (other processes, recorders, other types).
+      template <typename... Args>
+      bool PublishLocal(long long send_timestamp, const Args &...args)
+      {
+        std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+        bool send = PublishUnsubscribed() || subscriber_count_.load(std::memory_order_relaxed) > CountRegisteredReaders(*local_topic_);
+        if (local_topic_->subscribers.empty() && !history_)
+        {
+          return send;
+        }
+        auto sequence_number = ++local_sequence_number_;
+        if (history_)
+        {
+          history_->Store(args..., send_timestamp, sequence_number);
+        }
+        for (auto subscriber : local_topic_->subscribers)
+        {
+          subscriber->ReceiveLocalData(args..., send_timestamp, id_, sequence_number);
+        }
+        return send;
       }
 
     public:
       Publisher(const std::string &topic_name, const std::string &node_name, const std::string &node_namespace, MessageTypeSupport *ts, const PublisherQOS &qos)
-          : type_support_(ts)
+          : type_support_(ts), id_(CreatePublisherId())
       {
         using namespace std::placeholders;
 
         ros_qos_profile_ = qos.rmw_qos;
+        auto lifespan_us = ToMicroSeconds(qos.rmw_qos.lifespan);
+        Lifespans::Instance().AddLocal(id_, lifespan_us);
+        local_topic_ = IntraProcess::Instance().GetTopic(qos.topic_name_prefix + topic_name, type_support_->GetMessageName());
+        {
+          std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+          local_topic_->publishers.push_back(id_);
+        }
+        if (IsTransientLocal(&qos.rmw_qos))
+        {
+          history_.reset(new SampleHistory{ToHistoryDepth(qos.rmw_qos)});
+          replay_handle_ = std::make_shared<ReplayHandle>();
+          replay_handle_->publisher = this;
+          std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+          local_topic_->histories.emplace_back(id_, history_.get());
+        }
+
+        auto deadline_us = ToMicroSeconds(qos.rmw_qos.deadline);
+        if (deadline_us > 0)
+        {
+          deadline_.reset(new Deadline{deadline_us, deadline_missed_event_});
+        }
 
         publisher_ = eCAL::CPublisher(qos.topic_name_prefix + topic_name,
                                       type_support_->GetMessageName(),
                                       type_support_->GetTypeDescriptor());
         publisher_.SetQOS(qos.ecal_qos);
+        publisher_.SetID(id_);
+#ifdef RMW_ECAL_HAS_SHM_BUFFER_COUNT
+        auto shm_buffer_count = ShmBuffering::BufferCount(qos.shm_buffer_count);
+        if (shm_buffer_count > 0)
+        {
+          publisher_.ShmSetBufferCount(shm_buffer_count);
+        }
+        auto shm_acknowledge_timeout_ms = ShmBuffering::AcknowledgeTimeout(qos.shm_acknowledge_timeout_ms);
+        if (shm_acknowledge_timeout_ms > 0)
+        {
+          publisher_.ShmSetAcknowledgeTimeout(shm_acknowledge_timeout_ms);
+        }
+#endif
+        ApplyTopicLayer(publisher_, TopicLayerRules::Instance().Find(topic_name));
         publisher_.SetAttribute("node_name", node_name);
 	publisher_.SetAttribute("node_namespace", node_namespace);
-	publisher_.AddEventCallback(eCAL_Publisher_Event::pub_event_dropped, std::bind(&Publisher::OnDataDropped, this, _1, _2));
+        publisher_.SetAttribute(publisher_id_attribute, std::to_string(id_));
+        publisher_.SetAttribute(lifespan_attribute, std::to_string(lifespan_us));
+        publisher_.AddEventCallback(eCAL_Publisher_Event::pub_event_connected, std::bind(&Publisher::OnConnected, this, _1, _2));
+        publisher_.AddEventCallback(eCAL_Publisher_Event::pub_event_disconnected, std::bind(&Publisher::OnConnectionChanged, this, _1, _2));
+        publisher_.AddEventCallback(eCAL_Publisher_Event::pub_event_update_connection, std::bind(&Publisher::OnConnectionChanged, this, _1, _2));
+        subscriber_count_ = publisher_.GetSubscriberCount();
+
+        if (history_)
+        {
+          replay_publisher_.reset(new eCAL::CPublisher(ReplayTopicName(qos.topic_name_prefix + topic_name),
+                                                       type_support_->GetMessageName(),
+                                                       type_support_->GetTypeDescriptor()));
+          replay_publisher_->SetQOS(qos.ecal_qos);
+          replay_publisher_->SetID(id_);
+#ifdef RMW_ECAL_HAS_SHM_BUFFER_COUNT
+          auto replay_buffer_count = ShmBuffering::BufferCount(std::min<long>(static_cast<long>(ToHistoryDepth(qos.rmw_qos)), max_shm_buffer_count));
+          if (replay_buffer_count > 0)
+          {
+            replay_publisher_->ShmSetBufferCount(replay_buffer_count);
+          }
+          auto replay_acknowledge_timeout_ms = ShmBuffering::AcknowledgeTimeout(replay_shm_acknowledge_timeout_ms);
+          if (replay_acknowledge_timeout_ms > 0)
+          {
+            replay_publisher_->ShmSetAcknowledgeTimeout(replay_acknowledge_timeout_ms);
+          }
+#endif
+          ApplyTopicLayer(*replay_publisher_, TopicLayerRules::Instance().Find(topic_name));
+          //connected is reported for first subscriber only, update for every following one
+          replay_publisher_->AddEventCallback(eCAL_Publisher_Event::pub_event_connected, std::bind(&Publisher::OnReplayConnected, this, _1, _2));
+          replay_publisher_->AddEventCallback(eCAL_Publisher_Event::pub_event_update_connection, std::bind(&Publisher::OnReplayConnected, this, _1, _2));
+        }
+        liveliness_.reset(new PublisherLiveliness{publisher_,
+                                                  qos.rmw_qos.liveliness == RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC,
+                                                  ToMicroSeconds(qos.rmw_qos.liveliness_lease_duration),
+                                                  liveliness_lost_event_});
+      }
+
+      ~Publisher()
+      {
+        liveliness_.reset();
+        //connection callbacks use members destroyed before eCAL publisher
+        publisher_.Destroy();
+        if (replay_publisher_)
+        {
+          replay_publisher_->Destroy();
+        }
+        if (replay_handle_)
+        {
+          std::lock_guard<std::mutex> lock(replay_handle_->mutex);
+          replay_handle_->publisher = nullptr;
+        }
+        Lifespans::Instance().RemoveLocal(id_);
+        std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+        auto &publishers = local_topic_->publishers;
+        publishers.erase(std::remove(publishers.begin(), publishers.end(), id_), publishers.end());
+        auto &histories = local_topic_->histories;
+        histories.erase(std::remove_if(histories.begin(), histories.end(),
+                                       [this](const std::pair<long long, const SampleHistory *> &history) { return history.first == id_; }),
+                        histories.end());
       }
 
       void Publish(const void *data)
       {
-        auto serialized_data = type_support_->Serialize(data);
-        publisher_.Send(serialized_data.data(), serialized_data.size());
+        if (deadline_)
+        {
+          deadline_->Rearm();
+        }
+        liveliness_->Assert();
+        //transient local history has to be kept even without subscribers
+        if (!history_ && !IsSubscribed())
+        {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        auto &serialized_data = serialized_data_;
+        serialized_data.Clear();
+        type_support_->SerializeSegments(data, serialized_data);
+        auto send_timestamp = eCAL::Time::GetMicroSeconds();
+        if (!PublishLocal(send_timestamp, serialized_data))
+        {
+          return;
+        }
+        if (serialized_data.IsContiguous())
+        {
+          auto &buffer = serialized_data.Buffer();
+          publisher_.Send(buffer.data(), buffer.size(), send_timestamp);
+          return;
+        }
+#ifdef RMW_ECAL_HAS_PAYLOAD_WRITER
+        SegmentsPayloadWriter writer{serialized_data};
+        publisher_.Send(writer, send_timestamp);
+#endif
       }
 
       void PublishRaw(const void *data, const size_t data_size)
       {
-        publisher_.Send(data, data_size);
+        if (deadline_)
+        {
+          deadline_->Rearm();
+        }
+        liveliness_->Assert();
+        if (!history_ && !IsSubscribed())
+        {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        auto send_timestamp = eCAL::Time::GetMicroSeconds();
+        if (PublishLocal(send_timestamp, data, data_size))
+        {
+          publisher_.Send(data, data_size, send_timestamp);
+        }
       }
 
       size_t CountSubscribers() const
@@ -75,6 +386,11 @@ namespace eCAL
         return publisher_.GetSubscriberCount();
       }
 
+      long long GetId() const
+      {
+        return id_;
+      }
+
       const rmw_qos_profile_t &GetRosQOSProfile() const
       {
         return ros_qos_profile_;
@@ -90,9 +406,20 @@ namespace eCAL
         return publisher_.GetTypeName();
       }
 
-      Event &GetDataDroppedEventListener()
+      //Published messages assert liveliness too.
+      void AssertLiveliness()
+      {
+        liveliness_->Assert();
+      }
+
+      Event &GetDeadlineMissedEventListener()
+      {
+        return deadline_missed_event_;
+      }
+
+      Event &GetLivelinessLostEventListener()
       {
-        return data_dropped_event_;
+        return liveliness_lost_event_;
       }
 
       void UnregisterEvent(Event * /*event*/)
@@ -15,11 +15,13 @@
 #pragma once
 
 #include <limits>
+#include <cstdint>
 #include <stdexcept>
 
 #include <ecal/ecal.h>
 
 #include <rmw/types.h>
+#include <rmw/qos_profiles.h>
 
 namespace eCAL
 {
@@ -30,9 +32,18 @@ namespace eCAL
     static const std::string service_name_prefix{"rs"};
     static const std::string parameter_name_prefix{"rp"};
     static const std::string action_name_prefix{"ra"};
+    //history of transient local publishers, replay topic names are made of this prefix and eCAL topic name
+    static const std::string replay_name_prefix{"rh"};
     static const std::string private_symbol_prefix{"_"};
     static const std::string node_query_service_prefix{service_name_prefix + "/" + private_symbol_prefix + "node"};
 
+    //Upper limit of shared memory buffers per publisher, every buffer is as large as the biggest message sent.
+    constexpr long max_shm_buffer_count = 8;
+    //Longest time reliable keep all publishers wait for shared memory subscribers to read previous message.
+    constexpr long long keep_all_shm_acknowledge_timeout_ms = 100;
+    //Resource limit of keep all histories (transient local publishers), oldest messages are dropped beyond it.
+    constexpr size_t max_history_samples = 1000;
+
     inline std::string DemangleTopicName(const std::string &topic_name)
     {
       if (topic_name.substr(0, 3) == pub_name_prefix + "/")
@@ -45,6 +56,16 @@ namespace eCAL
       return pub_name_prefix + topic_name;
     }
 
+    inline std::string ReplayTopicName(const std::string &topic_name)
+    {
+      return replay_name_prefix + "/" + topic_name;
+    }
+
+    inline bool IsReplayTopicName(const std::string &topic_name)
+    {
+      return topic_name.compare(0, replay_name_prefix.size() + 1, replay_name_prefix + "/") == 0;
+    }
+
     inline std::string DemangleServiceName(const std::string &service_name)
     {
       if (service_name.substr(0, 3) == service_name_prefix + "/")
@@ -73,11 +94,77 @@ namespace eCAL
       return static_cast<int>(depth);
     }
 
+    //Keep last publishers get one buffer per history entry (at most max_shm_buffer_count), so a slow reader
+    //holding a buffer doesn't block the publisher, keep all publishers use the maximum.
+    //System default history keeps eCAL configuration, returns 0 for it.
+    inline long ToShmBufferCount(const rmw_qos_profile_t *rmw_qos)
+    {
+      if (rmw_qos->history == RMW_QOS_POLICY_HISTORY_KEEP_ALL)
+        return max_shm_buffer_count;
+      if (rmw_qos->history != RMW_QOS_POLICY_HISTORY_KEEP_LAST)
+        return 0;
+      if (rmw_qos->depth == 0)
+        return 1;
+      return rmw_qos->depth < static_cast<size_t>(max_shm_buffer_count) ? static_cast<long>(rmw_qos->depth) : max_shm_buffer_count;
+    }
+
+    //Reliable keep all publishers must not overwrite messages shared memory subscribers didn't read yet,
+    //so they wait for acknowledgement, bounded to keep crashed subscribers from blocking them.
+    //Others never wait, returns 0 for them.
+    inline long long ToShmAcknowledgeTimeout(const rmw_qos_profile_t *rmw_qos)
+    {
+      if (rmw_qos->history == RMW_QOS_POLICY_HISTORY_KEEP_ALL && rmw_qos->reliability == RMW_QOS_POLICY_RELIABILITY_RELIABLE)
+        return keep_all_shm_acknowledge_timeout_ms;
+      return 0;
+    }
+
+    inline bool IsInfinite(const rmw_time_t &duration)
+    {
+#ifdef RMW_DURATION_INFINITE
+      const rmw_time_t infinite = RMW_DURATION_INFINITE;
+      return duration.sec == infinite.sec && duration.nsec == infinite.nsec;
+#else
+      //distros before Galactic use zero for infinite durations
+      (void)duration;
+      return false;
+#endif
+    }
+
+    //Zero and infinite durations (or anything too long to be represented) disable the policy, returns 0 for them.
+    inline long long ToMicroSeconds(const rmw_time_t &duration)
+    {
+      //RMW_DURATION_INFINITE is just below the limit of long long nanoseconds, so it has to be compared explicitly
+      constexpr uint64_t max_sec = static_cast<uint64_t>(std::numeric_limits<long long>::max() / 1000000) - 1;
+      if (IsInfinite(duration) || duration.sec >= max_sec)
+        return 0;
+      return static_cast<long long>(duration.sec * 1000000 + duration.nsec / 1000);
+    }
+
+    //Number of messages kept by history of given QoS, depth 0 still keeps the last one.
+    inline size_t ToHistoryDepth(const rmw_qos_profile_t &rmw_qos)
+    {
+      if (rmw_qos.history == RMW_QOS_POLICY_HISTORY_KEEP_ALL)
+        return max_history_samples;
+      return rmw_qos.depth > 0 ? rmw_qos.depth : 1;
+    }
+
     inline bool IsPolicySpecified(rmw_qos_history_policy_t history_policy)
     {
       return history_policy != RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT && history_policy != RMW_QOS_POLICY_HISTORY_UNKNOWN;
     }
 
+    inline bool IsTransientLocal(const rmw_qos_profile_t *rmw_qos)
+    {
+      return rmw_qos->durability == RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+    }
+
+    //Manual by node liveliness is deprecated, every policy besides manual by topic is treated as automatic.
+    inline rmw_qos_liveliness_policy_t ToSupportedLiveliness(rmw_qos_liveliness_policy_t liveliness)
+    {
+      return liveliness == RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC ? RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC
+                                                                     : RMW_QOS_POLICY_LIVELINESS_AUTOMATIC;
+    }
+
     inline bool IsPolicySpecified(rmw_qos_reliability_policy_t history_policy)
     {
       return history_policy != RMW_QOS_POLICY_RELIABILITY_SYSTEM_DEFAULT && history_policy != RMW_QOS_POLICY_RELIABILITY_UNKNOWN;
@@ -140,6 +227,10 @@ namespace eCAL
       rmw_qos_profile_t rmw_qos;
       eCAL::QOS::SWriterQOS ecal_qos;
       std::string topic_name_prefix;
+      //0 keeps eCAL configuration
+      long shm_buffer_count;
+      //0 keeps eCAL configuration
+      long long shm_acknowledge_timeout_ms;
     };
 
     inline PublisherQOS CreatePublisherQOS(const rmw_qos_profile_t *rmw_qos)
@@ -154,16 +245,18 @@ namespace eCAL
         qos.ecal_qos.reliability = ToECalPolicy(rmw_qos->reliability);
       }
       qos.ecal_qos.history_kind_depth = ToECalDepth(rmw_qos->depth);
+      qos.shm_buffer_count = ToShmBufferCount(rmw_qos);
+      qos.shm_acknowledge_timeout_ms = ToShmAcknowledgeTimeout(rmw_qos);
 
       qos.rmw_qos.avoid_ros_namespace_conventions = rmw_qos->avoid_ros_namespace_conventions;
       qos.rmw_qos.depth = rmw_qos->depth;
       qos.rmw_qos.history = ToRosPolicy(qos.ecal_qos.history_kind);
       qos.rmw_qos.reliability = ToRosPolicy(qos.ecal_qos.reliability);
-      qos.rmw_qos.deadline = {0, 0};
-      qos.rmw_qos.durability = RMW_QOS_POLICY_DURABILITY_VOLATILE;
-      qos.rmw_qos.lifespan = {0, 0};
-      qos.rmw_qos.liveliness = RMW_QOS_POLICY_LIVELINESS_UNKNOWN;
-      qos.rmw_qos.liveliness_lease_duration = {0, 0};
+      qos.rmw_qos.deadline = rmw_qos->deadline;
+      qos.rmw_qos.durability = IsTransientLocal(rmw_qos) ? RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL : RMW_QOS_POLICY_DURABILITY_VOLATILE;
+      qos.rmw_qos.lifespan = rmw_qos->lifespan;
+      qos.rmw_qos.liveliness = ToSupportedLiveliness(rmw_qos->liveliness);
+      qos.rmw_qos.liveliness_lease_duration = rmw_qos->liveliness_lease_duration;
 
       if (!rmw_qos->avoid_ros_namespace_conventions)
       {
@@ -197,11 +290,11 @@ namespace eCAL
       qos.rmw_qos.depth = rmw_qos->depth;
       qos.rmw_qos.history = ToRosPolicy(qos.ecal_qos.history_kind);
       qos.rmw_qos.reliability = ToRosPolicy(qos.ecal_qos.reliability);
-      qos.rmw_qos.deadline = {0, 0};
-      qos.rmw_qos.durability = RMW_QOS_POLICY_DURABILITY_VOLATILE;
-      qos.rmw_qos.lifespan = {0, 0};
-      qos.rmw_qos.liveliness = RMW_QOS_POLICY_LIVELINESS_UNKNOWN;
-      qos.rmw_qos.liveliness_lease_duration = {0, 0};
+      qos.rmw_qos.deadline = rmw_qos->deadline;
+      qos.rmw_qos.durability = IsTransientLocal(rmw_qos) ? RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL : RMW_QOS_POLICY_DURABILITY_VOLATILE;
+      qos.rmw_qos.lifespan = rmw_qos->lifespan;
+      qos.rmw_qos.liveliness = ToSupportedLiveliness(rmw_qos->liveliness);
+      qos.rmw_qos.liveliness_lease_duration = rmw_qos->liveliness_lease_duration;
 
       if (!rmw_qos->avoid_ros_namespace_conventions)
       {
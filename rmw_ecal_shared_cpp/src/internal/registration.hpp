@@ -0,0 +1,88 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <ecal/ecal_config.h>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    namespace Registration
+    {
+      //Graph queries check whether registrations arrived this often until they are settled.
+      constexpr std::chrono::milliseconds poll_interval{50};
+
+      inline std::atomic<std::chrono::steady_clock::rep> &SettledAt()
+      {
+        static std::atomic<std::chrono::steady_clock::rep> settled_at{0};
+        return settled_at;
+      }
+
+      inline std::atomic<long long> &RefreshPeriodMs()
+      {
+        static std::atomic<long long> refresh_period_ms{1000};
+        return refresh_period_ms;
+      }
+
+      //eCAL processes broadcast their registration once per refresh period (ecal.ini registration_refresh,
+      //which can be overridden per process), entities of other processes are therefore known only after
+      //that time passed since initialization.
+      inline std::chrono::milliseconds RefreshPeriod()
+      {
+        return std::chrono::milliseconds{RefreshPeriodMs().load()};
+      }
+
+      inline void OnInitialized()
+      {
+        auto refresh_period_ms = eCAL::Config::GetRegistrationRefreshMs();
+        if (refresh_period_ms > 0)
+        {
+          RefreshPeriodMs().store(refresh_period_ms);
+        }
+        auto settled_at = std::chrono::steady_clock::now() + RefreshPeriod();
+        SettledAt().store(settled_at.time_since_epoch().count());
+      }
+
+      inline bool IsSettled()
+      {
+        std::chrono::steady_clock::time_point settled_at{std::chrono::steady_clock::duration{SettledAt().load()}};
+        return std::chrono::steady_clock::now() >= settled_at;
+      }
+
+      //Polls ready until it returns true, at most until registrations of already running processes could have been
+      //received. Only graph queries need complete picture, so initialization itself doesn't wait.
+      template <typename Ready>
+      inline void WaitUntilReady(Ready ready)
+      {
+        std::chrono::steady_clock::time_point settled_at{std::chrono::steady_clock::duration{SettledAt().load()}};
+        while (!ready())
+        {
+          auto now = std::chrono::steady_clock::now();
+          if (now >= settled_at)
+          {
+            return;
+          }
+          std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(poll_interval, settled_at - now));
+        }
+      }
+    } // namespace Registration
+  } // namespace rmw
+} // namespace eCAL
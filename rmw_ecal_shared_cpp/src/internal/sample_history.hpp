@@ -0,0 +1,98 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "rmw_ecal_shared_cpp/serialized_segments.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+
+    //Last serialized messages of transient local publisher, kept for late joining subscribers.
+    //Ring reuses buffers of overwritten messages and grows only as messages are stored.
+    class SampleHistory
+    {
+    public:
+      struct Sample
+      {
+        std::vector<char> data;
+        long long send_timestamp;
+        uint64_t sequence_number;
+      };
+
+    private:
+      std::vector<Sample> samples_;
+      size_t depth_;
+      size_t next_ = 0;
+
+      Sample &NextSample(long long send_timestamp, uint64_t sequence_number)
+      {
+        if (samples_.size() < depth_)
+        {
+          samples_.emplace_back();
+        }
+        auto &sample = samples_[next_];
+        next_ = (next_ + 1) % depth_;
+        sample.send_timestamp = send_timestamp;
+        sample.sequence_number = sequence_number;
+        return sample;
+      }
+
+    public:
+      explicit SampleHistory(size_t depth) : depth_(depth > 0 ? depth : 1)
+      {
+      }
+
+      void Store(const SerializedSegments &data, long long send_timestamp, uint64_t sequence_number)
+      {
+        auto &sample = NextSample(send_timestamp, sequence_number);
+        sample.data.resize(data.Size());
+        data.CopyTo(sample.data.data());
+      }
+
+      void Store(const void *data, size_t size, long long send_timestamp, uint64_t sequence_number)
+      {
+        auto &sample = NextSample(send_timestamp, sequence_number);
+        auto bytes = static_cast<const char *>(data);
+        sample.data.assign(bytes, bytes + size);
+      }
+
+      //Oldest sample first.
+      template <typename Func>
+      void ForEach(Func func) const
+      {
+        auto start = samples_.size() < depth_ ? 0 : next_;
+        for (size_t i = 0; i < samples_.size(); i++)
+        {
+          func(samples_[(start + i) % samples_.size()]);
+        }
+      }
+
+      //Oldest sample first, for sending without holding the lock guarding history.
+      std::vector<Sample> Copy() const
+      {
+        std::vector<Sample> samples;
+        samples.reserve(samples_.size());
+        ForEach([&samples](const Sample &sample) { samples.push_back(sample); });
+        return samples;
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
@@ -0,0 +1,65 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+#include <ecal/ecal.h>
+#include <ecal/ecal_config.h>
+
+#include "rmw_ecal_shared_cpp/ecal_config.hpp"
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    namespace ShmBuffering
+    {
+      inline std::atomic<bool> &ConfiguredByUser()
+      {
+        static std::atomic<bool> configured{false};
+        return configured;
+      }
+
+      inline std::atomic<bool> &AcknowledgeConfiguredByUser()
+      {
+        static std::atomic<bool> configured{false};
+        return configured;
+      }
+
+      //Buffer count and acknowledge timeout configured in ecal.ini or per process configuration take
+      //precedence over QoS, eCAL default is a single buffer without acknowledgement.
+      inline void OnInitialized(const EcalConfig &config)
+      {
+        ConfiguredByUser().store(config.values.count("publisher/memfile_buf_count") > 0 ||
+                                 eCAL::Config::GetMemfileBufferCount() > 1);
+        AcknowledgeConfiguredByUser().store(config.values.count("publisher/memfile_ack_timeout") > 0 ||
+                                            eCAL::Config::GetMemfileAckTimeoutMs() > 0);
+      }
+
+      //Number of shared memory buffers publisher should use, 0 keeps eCAL configuration.
+      inline long BufferCount(long qos_buffer_count)
+      {
+        return ConfiguredByUser().load() ? 0 : qos_buffer_count;
+      }
+
+      //Time publisher should wait for subscribers to read its messages, 0 keeps eCAL configuration.
+      inline long long AcknowledgeTimeout(long long qos_timeout_ms)
+      {
+        return AcknowledgeConfiguredByUser().load() ? 0 : qos_timeout_ms;
+      }
+    } // namespace ShmBuffering
+  } // namespace rmw
+} // namespace eCAL
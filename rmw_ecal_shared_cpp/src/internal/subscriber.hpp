@@ -17,20 +17,34 @@
 #include <ecal/ecal_time.h>
 #include <string>
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <vector>
+#include <utility>
 #include <memory>
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <unordered_map>
 
 #include <ecal/ecal.h>
 
 #include <rmw/types.h>
+#include <rcutils/logging_macros.h>
 
 #include "rmw_ecal_shared_cpp/message_typesupport.hpp"
+#include "rmw_ecal_shared_cpp/serialized_segments.hpp"
 
 #include "internal/qos.hpp"
 #include "internal/event.hpp"
+#include "internal/intra_process.hpp"
+#include "internal/deadline_timer.hpp"
+#include "internal/sample_history.hpp"
+#include "internal/gid.hpp"
+#include "internal/liveliness.hpp"
+#include "internal/lifespan.hpp"
 
 namespace eCAL
 {
@@ -42,65 +56,370 @@ namespace eCAL
     public:
       struct MessageInfo
       {
+        MessageInfo() = default;
         MessageInfo(long long send_timestamp_,
-                    long long receive_timestamp_)
+                    long long receive_timestamp_,
+                    long long publisher_id_,
+                    uint64_t publication_sequence_number_)
           : send_timestamp{send_timestamp_},
-            receive_timestamp{receive_timestamp_} {}
-        long long send_timestamp;
-        long long receive_timestamp;
+            receive_timestamp{receive_timestamp_},
+            publisher_id{publisher_id_},
+            publication_sequence_number{publication_sequence_number_} {}
+        long long send_timestamp = 0;
+        long long receive_timestamp = 0;
+        long long publisher_id = 0;
+        //counts messages sent by publisher
+        uint64_t publication_sequence_number = 0;
+        //counts messages received by this subscriber, assigned when message is queued
+        uint64_t reception_sequence_number = 0;
+        //lifespan of publisher, 0 if message never expires, negative while publisher's lifespan isn't known yet
+        long long lifespan_us = -1;
       };
 
       struct Data
       {
-        Data(char *data_, size_t size_,
-             long long send_timestamp_,
-             long long receive_timestamp_)
-          : data{data_},
-            size{size_},
-            info{send_timestamp_, receive_timestamp_} {}
-        char *data;
-        size_t size;
+        Data() = default;
+        Data(std::vector<char> buffer_, const MessageInfo &info_)
+          : buffer{std::move(buffer_)},
+            info{info_} {}
+        std::vector<char> buffer;
         MessageInfo info;
       };
 
     private:
+      //number of taken receive buffers kept for reuse
+      static constexpr size_t max_pooled_buffers = 8;
+
       std::unique_ptr<MessageTypeSupport> type_support_;
       eCAL::CSubscriber subscriber_;
+      //receives history replayed by transient local publishers, null for volatile subscribers
+      std::unique_ptr<eCAL::CSubscriber> replay_subscriber_;
 
       mutable std::mutex queue_mutex_;
       mutable std::mutex wait_set_mutex_;
+      std::mutex buffer_pool_mutex_;
 
       WaitSet *wait_set_ = nullptr;
-      Event data_dropped_event_;
-
-      std::queue<Data> data_;
+      Event deadline_missed_event_;
+      //rearmed by every received message, null if QoS has no deadline
+      std::unique_ptr<Deadline> deadline_;
+      Event message_lost_event_;
+      LivelinessChangedEvent liveliness_changed_event_;
+      //publishers are checked only for subscribers with finite lease or liveliness changed event
+      std::mutex liveliness_mutex_;
+      std::unique_ptr<SubscriberLiveliness> liveliness_;
+      long long liveliness_lease_us_ = 0;
+      bool ignore_local_publications_ = false;
+
+      std::deque<Data> data_;
+      uint64_t reception_sequence_number_ = 0;
+      struct PublisherState
+      {
+        //last publication sequence number, for gap detection
+        uint64_t sequence_number;
+        //send time of first message received live and of newest replayed message,
+        //replayed history is accepted only once and only for messages sent before subscription
+        bool has_live;
+        long long oldest_live_timestamp;
+        long long newest_replayed_timestamp;
+        //negative until publisher's lifespan is known
+        long long lifespan_us;
+      };
+      std::unordered_map<long long, PublisherState> publishers_;
+      bool transient_local_ = false;
+      uint64_t lost_count_ = 0;
+      //publishers whose lifespan isn't known yet and those with finite lifespan, queue is checked for expired messages only if there are any
+      size_t unresolved_lifespans_ = 0;
+      size_t finite_lifespans_ = 0;
+      std::vector<std::vector<char>> buffer_pool_;
+      std::shared_ptr<LocalTopic> local_topic_;
+      //publishers of this process whose loopback samples arrived, and whether they delivered them directly
+      std::mutex local_publishers_mutex_;
+      std::unordered_map<long long, bool> local_publishers_;
 
       rmw_qos_profile_t ros_qos_profile_;
 
+      //Samples of publishers in this process arrive through eCAL loopback too, those which were
+      //already delivered directly (or have to be ignored) are dropped.
+      //Publishers are registered with local topic before they send anything, their ids are never reused
+      //and their topic never changes, so answer is remembered and local topic is locked once per publisher.
+      bool IsLocallyDelivered(long long publisher_id)
+      {
+        if (!IsLocalPublisherId(publisher_id))
+        {
+          return false;
+        }
+        if (ignore_local_publications_)
+        {
+          return true;
+        }
+        std::lock_guard<std::mutex> lock(local_publishers_mutex_);
+        auto known = local_publishers_.find(publisher_id);
+        if (known != local_publishers_.end())
+        {
+          return known->second;
+        }
+        std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+        auto &publishers = local_topic_->publishers;
+        bool delivered = std::find(publishers.begin(), publishers.end(), publisher_id) != publishers.end();
+        local_publishers_.emplace(publisher_id, delivered);
+        return delivered;
+      }
+
+      //Samples of other processes which this process can't deserialize are dropped instead of being misparsed.
+      bool IsDeserializable(const eCAL::SReceiveCallbackData *data)
+      {
+        if (type_support_->CanDeserialize(data->buf, static_cast<size_t>(data->size)))
+        {
+          return true;
+        }
+        RCUTILS_LOG_WARN_ONCE_NAMED("rmw_ecal", "Dropping messages of %s, publisher serializes them in other wire layout.",
+                                    type_support_->GetMessageName().c_str());
+        return false;
+      }
+
       void OnReceiveData(const char * /* topic */, const eCAL::SReceiveCallbackData *data)
       {
+        if (IsLocallyDelivered(data->id) || !IsDeserializable(data))
+        {
+          return;
+        }
         auto receive_timestamp = eCAL::Time::GetMicroSeconds();
         auto latest_data = SaveData(data->buf, data->size);
-        EnqueueData(latest_data, data->size, data->time, receive_timestamp);
+        EnqueueData(std::move(latest_data), MessageInfo{data->time, receive_timestamp, data->id, static_cast<uint64_t>(data->clock)});
         NotifyWaitSet();
       }
 
-      void OnDataDropped(const char * /* topic_name */, const eCAL::SSubEventCallbackData * /* data */)
+      void OnReceiveReplay(const char * /* topic */, const eCAL::SReceiveCallbackData *data)
       {
-        data_dropped_event_.Trigger();
+        if (IsLocallyDelivered(data->id) || !IsDeserializable(data))
+        {
+          return;
+        }
+        auto receive_timestamp = eCAL::Time::GetMicroSeconds();
+        auto latest_data = SaveData(data->buf, data->size);
+        if (EnqueueReplay(std::move(latest_data), MessageInfo{data->time, receive_timestamp, data->id, 0}))
+        {
+          NotifyWaitSet();
+        }
       }
 
-      char *SaveData(void *data, size_t data_size)
+      std::vector<char> SaveData(const void *data, size_t data_size)
       {
-        auto latest_data = new char[data_size];
-        std::memcpy(latest_data, data, data_size);
+        auto latest_data = AcquireBuffer(data_size);
+        auto bytes = static_cast<const char *>(data);
+        latest_data.assign(bytes, bytes + data_size);
         return latest_data;
       }
 
-      void EnqueueData(char *data, size_t size, long long send_timestamp, long long recieve_timestamp)
+      std::vector<char> AcquireBuffer(size_t data_size)
       {
-        std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-        data_.emplace(data, size, send_timestamp, recieve_timestamp);
+        std::vector<char> latest_data;
+        {
+          //prefer smallest buffer which fits, so large payloads never reallocate
+          std::lock_guard<std::mutex> pool_lock(buffer_pool_mutex_);
+          auto best = buffer_pool_.end();
+          for (auto it = buffer_pool_.begin(); it != buffer_pool_.end(); ++it)
+          {
+            auto fits = it->capacity() >= data_size;
+            auto best_fits = best != buffer_pool_.end() && best->capacity() >= data_size;
+            if (best == buffer_pool_.end() ||
+                (fits && (!best_fits || it->capacity() < best->capacity())) ||
+                (!fits && !best_fits && it->capacity() > best->capacity()))
+            {
+              best = it;
+            }
+          }
+          if (best != buffer_pool_.end())
+          {
+            std::swap(*best, buffer_pool_.back());
+            latest_data = std::move(buffer_pool_.back());
+            buffer_pool_.pop_back();
+          }
+        }
+        return latest_data;
+      }
+
+      void RecycleData(std::vector<char> &&data)
+      {
+        std::lock_guard<std::mutex> pool_lock(buffer_pool_mutex_);
+        if (buffer_pool_.size() < max_pooled_buffers)
+        {
+          buffer_pool_.push_back(std::move(data));
+        }
+      }
+
+      //Messages missing between two consecutive messages of the same publisher were lost on the way,
+      //sequence number going backwards means publisher was recreated with same id.
+      //eCAL drop events carry no count, the same clock gaps are counted here.
+      uint64_t DetectGap(PublisherState &state, bool first, const MessageInfo &info)
+      {
+        uint64_t lost = 0;
+        if (!first && info.publication_sequence_number > state.sequence_number + 1)
+        {
+          lost = info.publication_sequence_number - state.sequence_number - 1;
+        }
+        state.sequence_number = info.publication_sequence_number;
+        return lost;
+      }
+
+      PublisherState &GetPublisherState(long long publisher_id)
+      {
+        auto inserted = publishers_.emplace(publisher_id, PublisherState{0, false, 0, std::numeric_limits<long long>::min(), -1});
+        if (inserted.second)
+        {
+          unresolved_lifespans_++;
+        }
+        return inserted.first->second;
+      }
+
+      //Lifespan is looked up once per publisher, publishers of other processes might become known
+      //only after their first messages arrived, those are resolved when they are taken.
+      long long ResolveLifespan(PublisherState &state, long long publisher_id)
+      {
+        if (state.lifespan_us >= 0)
+        {
+          return state.lifespan_us;
+        }
+        long long lifespan_us = 0;
+        if (!Lifespans::Instance().Find(publisher_id, lifespan_us))
+        {
+          LivelinessMonitor::Instance().RequestLifespans();
+          return -1;
+        }
+        state.lifespan_us = lifespan_us;
+        unresolved_lifespans_--;
+        if (lifespan_us > 0)
+        {
+          finite_lifespans_++;
+        }
+        return lifespan_us;
+      }
+
+      //Expired messages are dropped without being deserialized, so lagging subscriber catches up.
+      //They are neither lost nor taken.
+      void DropExpired()
+      {
+        if (unresolved_lifespans_ == 0 && finite_lifespans_ == 0)
+        {
+          return;
+        }
+        auto now = eCAL::Time::GetMicroSeconds();
+        for (auto it = data_.begin(); it != data_.end();)
+        {
+          auto &info = it->info;
+          if (info.lifespan_us < 0)
+          {
+            info.lifespan_us = ResolveLifespan(GetPublisherState(info.publisher_id), info.publisher_id);
+          }
+          if (info.lifespan_us > 0 && info.send_timestamp < now - info.lifespan_us)
+          {
+            RecycleData(std::move(it->buffer));
+            it = data_.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+      }
+
+      //Replays are sent to all transient local subscribers whenever one joins, those which already have the messages drop them.
+      //Messages sent after first live message were received live, older ones are accepted only while that live
+      //message is still queued, so history is never taken after live messages of the same publisher.
+      bool AcceptReplay(PublisherState &state, long long publisher_id, long long send_timestamp, std::deque<Data>::iterator &position)
+      {
+        if ((state.has_live && send_timestamp >= state.oldest_live_timestamp) ||
+            send_timestamp <= state.newest_replayed_timestamp)
+        {
+          return false;
+        }
+        position = data_.end();
+        if (state.has_live)
+        {
+          position = std::find_if(data_.begin(), data_.end(), [&](const Data &queued) {
+            return queued.info.publisher_id == publisher_id && queued.info.send_timestamp == state.oldest_live_timestamp;
+          });
+          if (position == data_.end())
+          {
+            return false;
+          }
+        }
+        state.newest_replayed_timestamp = send_timestamp;
+        return true;
+      }
+
+      //Keep last history drops oldest messages nobody took in time, returns their number.
+      uint64_t DropOverflow()
+      {
+        uint64_t dropped = 0;
+        if (ros_qos_profile_.history == RMW_QOS_POLICY_HISTORY_KEEP_LAST && ros_qos_profile_.depth > 0)
+        {
+          while (data_.size() > ros_qos_profile_.depth)
+          {
+            RecycleData(std::move(data_.front().buffer));
+            data_.pop_front();
+            dropped++;
+          }
+        }
+        return dropped;
+      }
+
+      void TriggerLost(uint64_t lost)
+      {
+        //wait set locks its condition before checking queue, so event is triggered outside of queue lock
+        if (lost > 0)
+        {
+          message_lost_event_.Trigger(lost);
+        }
+      }
+
+      void EnqueueData(std::vector<char> &&data, MessageInfo info)
+      {
+        if (deadline_)
+        {
+          deadline_->Rearm();
+        }
+        uint64_t lost = 0;
+        {
+          std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+          auto &state = GetPublisherState(info.publisher_id);
+          lost = DetectGap(state, !state.has_live, info);
+          if (!state.has_live)
+          {
+            state.has_live = true;
+            state.oldest_live_timestamp = info.send_timestamp;
+          }
+          info.reception_sequence_number = ++reception_sequence_number_;
+          info.lifespan_us = ResolveLifespan(state, info.publisher_id);
+          data_.emplace_back(std::move(data), info);
+          lost += DropOverflow();
+          lost_count_ += lost;
+        }
+        TriggerLost(lost);
+      }
+
+      //Replayed messages are numbered by replay publisher, so they don't take part in gap detection.
+      bool EnqueueReplay(std::vector<char> &&data, MessageInfo info)
+      {
+        uint64_t lost = 0;
+        {
+          std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+          auto &state = GetPublisherState(info.publisher_id);
+          std::deque<Data>::iterator position;
+          if (!AcceptReplay(state, info.publisher_id, info.send_timestamp, position))
+          {
+            RecycleData(std::move(data));
+            return false;
+          }
+          info.reception_sequence_number = ++reception_sequence_number_;
+          info.lifespan_us = ResolveLifespan(state, info.publisher_id);
+          data_.emplace(position, std::move(data), info);
+          lost = DropOverflow();
+          lost_count_ += lost;
+        }
+        TriggerLost(lost);
+        return true;
       }
 
       void NotifyWaitSet()
@@ -113,21 +432,38 @@ namespace eCAL
         }
       }
 
-      Data PopData()
+      //Returns false if queue is empty or all queued messages expired.
+      bool PopData(Data &latest_data)
       {
         std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-        auto latest_data = data_.front();
-        data_.pop();
+        DropExpired();
+        if (data_.empty())
+        {
+          return false;
+        }
+        latest_data = std::move(data_.front());
+        data_.pop_front();
 
-        return latest_data;
+        return true;
       }
 
-      void CleanupData()
+      //Puts message which couldn't be taken back in front of queue, unless history overflowed meanwhile.
+      void RequeueData(Data &&latest_data)
       {
-        while (HasData())
+        uint64_t lost = 0;
         {
-          delete[] PopData().data;
+          std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+          data_.push_front(std::move(latest_data));
+          lost = DropOverflow();
+          lost_count_ += lost;
         }
+        TriggerLost(lost);
+      }
+
+      void CleanupData()
+      {
+        std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+        data_.clear();
       }
 
       WaitSet *GetAttachedWaitSet() const
@@ -137,12 +473,18 @@ namespace eCAL
       }
 
     public:
-      Subscriber(const std::string &topic_name, const std::string &node_name, const std::string &node_namespace, MessageTypeSupport *ts, const SubscriberQOS &qos)
+      Subscriber(const std::string &topic_name, const std::string &node_name, const std::string &node_namespace, MessageTypeSupport *ts, const SubscriberQOS &qos,
+                 bool ignore_local_publications = false)
           : type_support_(ts)
       {
         using namespace std::placeholders;
 
         ros_qos_profile_ = qos.rmw_qos;
+        transient_local_ = IsTransientLocal(&qos.rmw_qos);
+        liveliness_lease_us_ = ToMicroSeconds(qos.rmw_qos.liveliness_lease_duration);
+        ignore_local_publications_ = ignore_local_publications;
+        //receive callbacks check local publishers, so topic has to be known before they are added
+        local_topic_ = IntraProcess::Instance().GetTopic(qos.topic_name_prefix + topic_name, type_support_->GetMessageName());
 
         subscriber_ = eCAL::CSubscriber(qos.topic_name_prefix + topic_name,
                                         type_support_->GetMessageName(),
@@ -152,35 +494,122 @@ namespace eCAL
         subscriber_.SetAttribute("node_name", node_name);
         subscriber_.SetAttribute("node_namespace", node_namespace);
 
+        auto deadline_us = ToMicroSeconds(qos.rmw_qos.deadline);
+        if (deadline_us > 0)
+        {
+          deadline_.reset(new Deadline{deadline_us, deadline_missed_event_});
+        }
+
         subscriber_.AddReceiveCallback(std::bind(&Subscriber::OnReceiveData, this, _1, _2));
-        subscriber_.AddEventCallback(eCAL_Subscriber_Event::sub_event_dropped, std::bind(&Subscriber::OnDataDropped, this, _1, _2));
+        if (transient_local_)
+        {
+          replay_subscriber_.reset(new eCAL::CSubscriber(ReplayTopicName(qos.topic_name_prefix + topic_name),
+                                                         type_support_->GetMessageName(),
+                                                         type_support_->GetTypeDescriptor()));
+          replay_subscriber_->SetQOS(qos.ecal_qos);
+          replay_subscriber_->AddReceiveCallback(std::bind(&Subscriber::OnReceiveReplay, this, _1, _2));
+        }
+        if (liveliness_lease_us_ > 0)
+        {
+          TrackLiveliness();
+        }
+
+        std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+        local_topic_->readers.emplace_back(this, std::chrono::steady_clock::now());
+        //not registering for local delivery ignores all publishers of this process
+        if (!ignore_local_publications)
+        {
+          //history is copied under the same lock publishers hold while storing and delivering,
+          //so no message is received twice or missed
+          local_topic_->subscribers.push_back(this);
+          if (transient_local_)
+          {
+            for (const auto &history : local_topic_->histories)
+            {
+              history.second->ForEach([&](const SampleHistory::Sample &sample) {
+                ReceiveLocalData(sample.data.data(), sample.data.size(), sample.send_timestamp, history.first, sample.sequence_number);
+              });
+            }
+          }
+        }
       }
 
+      //Messages of publishers in the same process, they don't pass through eCAL.
+      void ReceiveLocalData(const SerializedSegments &data, long long send_timestamp, long long publisher_id, uint64_t sequence_number)
+      {
+        //appended segment by segment, resize would zero fill memory which is overwritten anyway
+        auto latest_data = AcquireBuffer(data.Size());
+        latest_data.clear();
+        latest_data.reserve(data.Size());
+        data.ForEachSegment([&latest_data](const char *segment, size_t size) {
+          latest_data.insert(latest_data.end(), segment, segment + size);
+        });
+        EnqueueData(std::move(latest_data), MessageInfo{send_timestamp, eCAL::Time::GetMicroSeconds(), publisher_id, sequence_number});
+        NotifyWaitSet();
+      }
 
-      MessageInfo TakeLatestDataWithInfo(void *data)
+      void ReceiveLocalData(const void *data, size_t size, long long send_timestamp, long long publisher_id, uint64_t sequence_number)
       {
-        auto latest_data = PopData();
-        type_support_->Deserialize(data, latest_data.data, latest_data.size);
-        delete[] latest_data.data;
-        return latest_data.info;
+        auto latest_data = SaveData(data, size);
+        EnqueueData(std::move(latest_data), MessageInfo{send_timestamp, eCAL::Time::GetMicroSeconds(), publisher_id, sequence_number});
+        NotifyWaitSet();
+      }
+
+
+      //Takes oldest message which didn't expire yet, returns false if there is none.
+      bool TakeLatestDataWithInfo(void *data, MessageInfo &info)
+      {
+        Data latest_data;
+        if (!PopData(latest_data))
+        {
+          return false;
+        }
+        type_support_->Deserialize(data, latest_data.buffer.data(), latest_data.buffer.size());
+        RecycleData(std::move(latest_data.buffer));
+        info = latest_data.info;
+        return true;
       }
 
-      void TakeLatestData(void *data)
+      bool TakeLatestData(void *data)
       {
-        TakeLatestDataWithInfo(data);
+        MessageInfo info;
+        return TakeLatestDataWithInfo(data, info);
       }
 
-      Data TakeLatestSerializedData()
+      //Passes serialized data to func (const char *data, size_t size), which has to copy it out,
+      //receive buffer is reused for following messages. Message stays queued if func returns false.
+      template <typename Func>
+      bool TakeLatestSerializedData(Func func, MessageInfo &info)
       {
-        return PopData();
+        Data latest_data;
+        if (!PopData(latest_data))
+        {
+          return false;
+        }
+        if (!func(latest_data.buffer.data(), latest_data.buffer.size()))
+        {
+          RequeueData(std::move(latest_data));
+          return false;
+        }
+        RecycleData(std::move(latest_data.buffer));
+        info = latest_data.info;
+        return true;
       }
 
+      //Messages which expire until they are taken are counted too, so take might still find nothing.
       bool HasData() const
       {
         std::lock_guard<std::mutex> lock(queue_mutex_);
         return !data_.empty();
       }
 
+      //Total number of messages lost on the way or evicted from history.
+      uint64_t CountLostMessages() const
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        return lost_count_;
+      }
+
       size_t CountPublishers() const
       {
         return subscriber_.GetPublisherCount();
@@ -201,9 +630,30 @@ namespace eCAL
         return ros_qos_profile_;
       }
 
-      Event &GetDataDroppedEventListener()
+      Event &GetDeadlineMissedEventListener()
+      {
+        return deadline_missed_event_;
+      }
+
+      Event &GetMessageLostEventListener()
+      {
+        return message_lost_event_;
+      }
+
+      //Starts checking liveliness of publishers, if it isn't checked already.
+      void TrackLiveliness()
+      {
+        std::lock_guard<std::mutex> lock(liveliness_mutex_);
+        if (!liveliness_)
+        {
+          liveliness_.reset(new SubscriberLiveliness{subscriber_.GetTopicName(), liveliness_lease_us_,
+                                                     ignore_local_publications_, liveliness_changed_event_});
+        }
+      }
+
+      LivelinessChangedEvent &GetLivelinessChangedEventListener()
       {
-        return data_dropped_event_;
+        return liveliness_changed_event_;
       }
 
       void AttachWaitSet(WaitSet *wait_set)
@@ -220,6 +670,25 @@ namespace eCAL
 
       ~Subscriber()
       {
+        //receive callbacks use members destroyed before eCAL subscribers
+        subscriber_.Destroy();
+        if (replay_subscriber_)
+        {
+          replay_subscriber_->Destroy();
+        }
+        {
+          std::lock_guard<std::mutex> lock(liveliness_mutex_);
+          liveliness_.reset();
+        }
+        {
+          std::lock_guard<std::mutex> local_lock(local_topic_->mutex);
+          auto &subscribers = local_topic_->subscribers;
+          subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), this), subscribers.end());
+          auto &readers = local_topic_->readers;
+          readers.erase(std::remove_if(readers.begin(), readers.end(),
+                                       [this](const std::pair<const Subscriber *, std::chrono::steady_clock::time_point> &reader) { return reader.first == this; }),
+                        readers.end());
+        }
         CleanupData();
       }
     };
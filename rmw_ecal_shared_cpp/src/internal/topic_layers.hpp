@@ -0,0 +1,153 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <stdexcept>
+
+#include <ecal/ecal.h>
+
+namespace eCAL
+{
+  namespace rmw
+  {
+    enum class TopicLayer
+    {
+      automatic,
+      shm,
+      udp,
+      tcp,
+      inproc
+    };
+
+    inline TopicLayer ParseTopicLayer(const std::string &layer)
+    {
+      if (layer == "auto")
+        return TopicLayer::automatic;
+      if (layer == "shm")
+        return TopicLayer::shm;
+      if (layer == "udp")
+        return TopicLayer::udp;
+      if (layer == "tcp")
+        return TopicLayer::tcp;
+      if (layer == "inproc")
+        return TopicLayer::inproc;
+      throw std::invalid_argument{"Unknown transport layer '" + layer + "', expected shm, udp, tcp, inproc or auto."};
+    }
+
+    //Glob match, '*' matches any (possibly empty) sequence of characters.
+    inline bool MatchTopicPattern(const std::string &pattern, const std::string &topic_name)
+    {
+      size_t p = 0, t = 0;
+      size_t star = std::string::npos, star_t = 0;
+      while (t < topic_name.size())
+      {
+        if (p < pattern.size() && pattern[p] == '*')
+        {
+          star = p++;
+          star_t = t;
+        }
+        else if (p < pattern.size() && pattern[p] == topic_name[t])
+        {
+          p++;
+          t++;
+        }
+        else if (star != std::string::npos)
+        {
+          p = star + 1;
+          t = ++star_t;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      while (p < pattern.size() && pattern[p] == '*')
+      {
+        p++;
+      }
+      return p == pattern.size();
+    }
+
+    //Restricts publisher to single transport layer, automatic keeps eCAL defaults.
+    inline void ApplyTopicLayer(eCAL::CPublisher &publisher, TopicLayer layer)
+    {
+      if (layer == TopicLayer::automatic)
+      {
+        return;
+      }
+      publisher.SetLayerMode(eCAL::TLayer::tlayer_all, eCAL::TLayer::smode_off);
+      switch (layer)
+      {
+      case TopicLayer::shm:
+        publisher.SetLayerMode(eCAL::TLayer::tlayer_shm, eCAL::TLayer::smode_on);
+        break;
+      case TopicLayer::udp:
+        publisher.SetLayerMode(eCAL::TLayer::tlayer_udp_mc, eCAL::TLayer::smode_on);
+        break;
+      case TopicLayer::tcp:
+        publisher.SetLayerMode(eCAL::TLayer::tlayer_tcp, eCAL::TLayer::smode_on);
+        break;
+      case TopicLayer::inproc:
+        publisher.SetLayerMode(eCAL::TLayer::tlayer_inproc, eCAL::TLayer::smode_on);
+        break;
+      default:
+        break;
+      }
+    }
+
+    //Process wide rules, set from init options when rmw is initialized.
+    class TopicLayerRules
+    {
+      std::mutex mutex_;
+      std::vector<std::pair<std::string, TopicLayer>> rules_;
+
+    public:
+      static TopicLayerRules &Instance()
+      {
+        static TopicLayerRules rules;
+        return rules;
+      }
+
+      void SetRules(const std::vector<std::pair<std::string, std::string>> &rules)
+      {
+        std::vector<std::pair<std::string, TopicLayer>> parsed_rules;
+        for (const auto &rule : rules)
+        {
+          parsed_rules.emplace_back(rule.first, ParseTopicLayer(rule.second));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        rules_ = std::move(parsed_rules);
+      }
+
+      TopicLayer Find(const std::string &topic_name)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &rule : rules_)
+        {
+          if (MatchTopicPattern(rule.first, topic_name))
+          {
+            return rule.second;
+          }
+        }
+        return TopicLayer::automatic;
+      }
+    };
+
+  } // namespace rmw
+} // namespace eCAL
@@ -19,10 +19,13 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <cstring>
+#include <stdexcept>
 
 #include <ecal/ecal.h>
 
 #include <rmw/impl/cpp/macros.hpp>
+#include <rmw/serialized_message.h>
 
 #include "rmw_ecal_shared_cpp/string_functions.hpp"
 
@@ -35,12 +38,33 @@
 #include "internal/client.hpp"
 #include "internal/guard_condition.hpp"
 #include "internal/graph.hpp"
+#include "internal/codec_cache.hpp"
+#include "internal/gid.hpp"
 
 namespace eCAL
 {
   namespace rmw
   {
 
+    namespace
+    {
+      void FillMessageInfo(const char *implementation_identifier, const Subscriber::MessageInfo &ecal_msg_info, rmw_message_info_t *message_info)
+      {
+        // eCAL timestamps are in microseconds but ROS expects them in nanoseconds
+        std::chrono::microseconds src_ts_ms{ecal_msg_info.send_timestamp};
+        std::chrono::microseconds rcv_ts_ms{ecal_msg_info.receive_timestamp};
+        message_info->source_timestamp =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(src_ts_ms).count();
+        message_info->received_timestamp =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(rcv_ts_ms).count();
+        ToGid(ecal_msg_info.publisher_id, implementation_identifier, &message_info->publisher_gid);
+#if ROS_DISTRO >= HUMBLE
+        message_info->publication_sequence_number = ecal_msg_info.publication_sequence_number;
+        message_info->reception_sequence_number = ecal_msg_info.reception_sequence_number;
+#endif
+      }
+    } // namespace
+
 #if ROS_DISTRO >= GALACTIC
     rmw_node_t *rmw_create_node(const char *implementation_identifier,
                                 rmw_context_t *context,
@@ -89,9 +113,13 @@ namespace eCAL
       return RMW_RET_OK;
     }
 
-    rmw_ret_t rmw_node_assert_liveliness(const char * /* implementation_identifier */, const rmw_node_t * /* node */)
+    //Manual by node liveliness is treated as automatic, nodes are alive as long as their process registers.
+    rmw_ret_t rmw_node_assert_liveliness(const char *implementation_identifier, const rmw_node_t *node)
     {
-      UNSUPPORTED;
+      RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+      CHECK_RMW_IMPLEMENTATION(implementation_identifier, node);
+
+      return RMW_RET_OK;
     }
 
     const rmw_guard_condition_t *rmw_node_get_graph_guard_condition(const char *implementation_identifier, const rmw_node_t *node)
@@ -204,11 +232,20 @@ namespace eCAL
     }
 
     rmw_ret_t rmw_get_serialized_message_size(const char * /* implementation_identifier */,
-                                              const rosidl_message_type_support_t * /* type_support */,
+                                              const SerializerFactory &ecal_serializer_factory,
+                                              const rosidl_message_type_support_t *type_support,
                                               const rosidl_runtime_c__Sequence__bound * /* message_bounds */,
-                                              size_t * /* size */)
+                                              size_t *size)
     {
-      UNSUPPORTED;
+      RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+      RMW_CHECK_ARGUMENT_FOR_NULL(size, RMW_RET_INVALID_ARGUMENT);
+
+      if (!ecal_serializer_factory.GetSerializedSizeBound(type_support, size))
+      {
+        RMW_SET_ERROR_MSG("Serialized size of this message type is unbounded or unknown.");
+        return RMW_RET_UNSUPPORTED;
+      }
+      return RMW_RET_OK;
     }
 
     rmw_ret_t rmw_serialize(const char * /* implementation_identifier */,
@@ -221,17 +258,26 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
       RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
 
-      std::unique_ptr<Serializer> ecal_ser{ecal_serializer_factory.CreateSerializer(type_support)};
-      auto serialized_bytes = ecal_ser->Serialize(ros_message);
-      auto no_of_bytes = serialized_bytes.size();
+      rmw_ret_t ret = RMW_RET_OK;
+      CodecCache::Instance().WithSerializer(ecal_serializer_factory, type_support,
+                                            [&](Serializer &ecal_ser, SerializedSegments &serialized_data) {
+        ecal_ser.SerializeSegments(ros_message, serialized_data);
+        auto no_of_bytes = serialized_data.Size();
 
-      serialized_message->buffer_capacity = no_of_bytes;
-      serialized_message->buffer_length = no_of_bytes;
-      serialized_message->buffer = new uint8_t[no_of_bytes];
-      //not very efficient, should find a way to avoid this copy
-      std::copy_n(serialized_bytes.data(), no_of_bytes, serialized_message->buffer);
+        //buffer is owned by caller, grow it through its allocator only if it is too small
+        if (serialized_message->buffer_capacity < no_of_bytes)
+        {
+          ret = rmw_serialized_message_resize(serialized_message, no_of_bytes);
+          if (ret != RMW_RET_OK)
+          {
+            return;
+          }
+        }
+        serialized_data.CopyTo(serialized_message->buffer);
+        serialized_message->buffer_length = no_of_bytes;
+      });
 
-      return RMW_RET_OK;
+      return ret;
     }
 
     rmw_ret_t rmw_deserialize(const char * /* implementation_identifier */,
@@ -240,8 +286,18 @@ namespace eCAL
                               const rosidl_message_type_support_t *type_support,
                               void *ros_message)
     {
-      std::unique_ptr<Deserializer> ecal_deser{ecal_serializer_factory.CreateDeserializer(type_support)};
-      ecal_deser->Deserialize(ros_message, serialized_message->buffer, serialized_message->buffer_length);
+      //messages serialized in other wire layout are rejected
+      try
+      {
+        CodecCache::Instance().WithDeserializer(ecal_serializer_factory, type_support, [&](Deserializer &ecal_deser) {
+          ecal_deser.Deserialize(ros_message, serialized_message->buffer, serialized_message->buffer_length);
+        });
+      }
+      catch (const std::runtime_error &e)
+      {
+        RMW_SET_ERROR_MSG(e.what());
+        return RMW_RET_ERROR;
+      }
 
       return RMW_RET_OK;
     }
@@ -264,7 +320,7 @@ namespace eCAL
       auto ecal_node = GetImplementation(node);
       auto ecal_ts = ecal_typesupport_factory.Create(type_support);
       auto ecal_qos = CreateSubscriberQOS(qos_policies);
-      auto ecal_sub = ecal_node->CreateSubscriber(topic_name, ecal_ts, ecal_qos);
+      auto ecal_sub = ecal_node->CreateSubscriber(topic_name, ecal_ts, ecal_qos, subscription_options->ignore_local_publications);
 
       auto rmw_sub = ::rmw_subscription_allocate();
       rmw_sub->implementation_identifier = implementation_identifier;
@@ -315,10 +371,7 @@ namespace eCAL
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, subscription);
 
       auto ecal_sub = GetImplementation(subscription);
-      if (!ecal_sub->HasData())
-        return RMW_RET_OK;
-      ecal_sub->TakeLatestData(ros_message);
-      *taken = true;
+      *taken = ecal_sub->TakeLatestData(ros_message);
 
       return RMW_RET_OK;
     }
@@ -336,17 +389,12 @@ namespace eCAL
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, subscription);
 
       auto ecal_sub = GetImplementation(subscription);
-      if (!ecal_sub->HasData())
-        return RMW_RET_OK;
-      auto ecal_msg_info = ecal_sub->TakeLatestDataWithInfo(ros_message);
-      // eCAL timestamps are in microseconds but ROS expects them in nanoseconds
-      std::chrono::microseconds src_ts_ms{ecal_msg_info.send_timestamp};
-      std::chrono::microseconds rcv_ts_ms{ecal_msg_info.receive_timestamp};
-      message_info->source_timestamp =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(src_ts_ms).count();
-      message_info->received_timestamp =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(rcv_ts_ms).count();
-      *taken = true;
+      Subscriber::MessageInfo ecal_msg_info;
+      *taken = ecal_sub->TakeLatestDataWithInfo(ros_message, ecal_msg_info);
+      if (*taken)
+      {
+        FillMessageInfo(implementation_identifier, ecal_msg_info, message_info);
+      }
 
       return RMW_RET_OK;
     }
@@ -378,11 +426,14 @@ namespace eCAL
 
       *taken = 0;
       auto ecal_sub = GetImplementation(subscription);
-      while (ecal_sub->HasData() && *taken != count)
+      Subscriber::MessageInfo ecal_msg_info;
+      while (*taken != count && ecal_sub->TakeLatestDataWithInfo(message_sequence->data[*taken], ecal_msg_info))
       {
-        ecal_sub->TakeLatestData(message_sequence->data[*taken]);
+        FillMessageInfo(implementation_identifier, ecal_msg_info, message_info_sequence->data + *taken);
         (*taken)++;
       }
+      message_sequence->size = *taken;
+      message_info_sequence->size = *taken;
 
       return RMW_RET_OK;
     }
@@ -391,36 +442,56 @@ namespace eCAL
                                           const rmw_subscription_t *subscription,
                                           rmw_serialized_message_t *serialized_message,
                                           bool *taken,
-                                          rmw_subscription_allocation_t * /* allocation */)
+                                          rmw_subscription_allocation_t *allocation)
+    {
+      return rmw_take_serialized_message_with_info(implementation_identifier, subscription, serialized_message, taken, nullptr, allocation);
+    }
+
+    rmw_ret_t rmw_take_serialized_message_with_info(const char *implementation_identifier,
+                                                    const rmw_subscription_t *subscription,
+                                                    rmw_serialized_message_t *serialized_message,
+                                                    bool *taken,
+                                                    rmw_message_info_t *message_info,
+                                                    rmw_subscription_allocation_t * /* allocation */)
     {
       RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
       RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
       RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, subscription);
 
+      *taken = false;
       auto ecal_sub = GetImplementation(subscription);
-      if (!ecal_sub->HasData())
-        return RMW_RET_OK;
+      rmw_ret_t ret = RMW_RET_OK;
+      Subscriber::MessageInfo ecal_msg_info;
+      bool message_taken = ecal_sub->TakeLatestSerializedData([&](const char *data, size_t size) {
+        //buffer is owned by caller, grow it through its allocator only if it is too small,
+        //message stays queued if that fails
+        if (serialized_message->buffer_capacity < size)
+        {
+          ret = rmw_serialized_message_resize(serialized_message, size);
+          if (ret != RMW_RET_OK)
+          {
+            return false;
+          }
+        }
+        std::memcpy(serialized_message->buffer, data, size);
+        serialized_message->buffer_length = size;
+        return true;
+      }, ecal_msg_info);
+      if (!message_taken || ret != RMW_RET_OK)
+      {
+        return ret;
+      }
 
-      auto data = ecal_sub->TakeLatestSerializedData();
-      serialized_message->buffer = reinterpret_cast<uint8_t *>(data.data);
-      serialized_message->buffer_length = data.size;
-      serialized_message->buffer_capacity = data.size;
+      if (message_info != nullptr)
+      {
+        FillMessageInfo(implementation_identifier, ecal_msg_info, message_info);
+      }
       *taken = true;
 
       return RMW_RET_OK;
     }
 
-    rmw_ret_t rmw_take_serialized_message_with_info(const char *implementation_identifier,
-                                                    const rmw_subscription_t *subscription,
-                                                    rmw_serialized_message_t *serialized_message,
-                                                    bool *taken,
-                                                    rmw_message_info_t * /* message_info */,
-                                                    rmw_subscription_allocation_t *allocation)
-    {
-      return rmw_take_serialized_message(implementation_identifier, subscription, serialized_message, taken, allocation);
-    }
-
     rmw_client_t *rmw_create_client(const char *implementation_identifier,
                                     const TypesupportFactory &ecal_typesupport_factory,
                                     const rmw_node_t *node,
@@ -905,8 +976,8 @@ namespace eCAL
       RMW_CHECK_ARGUMENT_FOR_NULL(gid, RMW_RET_INVALID_ARGUMENT);
       CHECK_RMW_IMPLEMENTATION(implementation_identifier, publisher);
 
-      gid->implementation_identifier = implementation_identifier;
-      std::fill(std::begin(gid->data), std::end(gid->data), uint8_t{0});
+      auto ecal_pub = GetImplementation(publisher);
+      ToGid(ecal_pub->GetId(), implementation_identifier, gid);
 
       return RMW_RET_OK;
     }
@@ -990,10 +1061,15 @@ namespace eCAL
       UNSUPPORTED;
     }
 
-    rmw_ret_t rmw_publisher_assert_liveliness(const char * /* implementation_identifier */,
-                                              const rmw_publisher_t * /* publisher */)
+    rmw_ret_t rmw_publisher_assert_liveliness(const char *implementation_identifier,
+                                              const rmw_publisher_t *publisher)
     {
-      UNSUPPORTED;
+      RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+      CHECK_RMW_IMPLEMENTATION(implementation_identifier, publisher);
+
+      GetImplementation(publisher)->AssertLiveliness();
+
+      return RMW_RET_OK;
     }
 
     rmw_ret_t rmw_init_subscription_allocation(const char * /* implementation_identifier */,
@@ -1070,7 +1146,14 @@ namespace eCAL
 
     bool rmw_feature_supported(rmw_feature_t feature)
     {
-        UNSUPPORTED; // ?
+      switch (feature)
+      {
+      case RMW_FEATURE_MESSAGE_INFO_PUBLICATION_SEQUENCE_NUMBER:
+      case RMW_FEATURE_MESSAGE_INFO_RECEPTION_SEQUENCE_NUMBER:
+        return true;
+      default:
+        return false;
+      }
     }
 
     rmw_ret_t rmw_subscription_set_content_filter(rmw_subscription_t * subscription, const rmw_subscription_content_filter_options_t * options)
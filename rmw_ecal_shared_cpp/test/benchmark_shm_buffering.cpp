@@ -0,0 +1,103 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//Shared memory throughput of a publisher depending on its buffer count, with a subscriber slower than the publisher.
+//Run subscriber and publisher as separate processes:
+//  benchmark_shm_buffering sub [processing time us]
+//  benchmark_shm_buffering pub [buffer count] [message size bytes] [duration s]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ecal/ecal.h>
+
+namespace
+{
+  const std::string topic_name{"rmw_ecal_benchmark_shm_buffering"};
+
+  int RunSubscriber(long long processing_time_us)
+  {
+    eCAL::CSubscriber subscriber{topic_name};
+    long long received = 0;
+    subscriber.AddReceiveCallback([&](const char *, const eCAL::SReceiveCallbackData *) {
+      received++;
+      std::this_thread::sleep_for(std::chrono::microseconds(processing_time_us));
+    });
+    while (eCAL::Ok())
+    {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      std::cout << "received " << received << " messages/s" << std::endl;
+      received = 0;
+    }
+    return 0;
+  }
+
+  int RunPublisher(long buffer_count, size_t message_size, int duration_s)
+  {
+    eCAL::CPublisher publisher{topic_name};
+    publisher.SetLayerMode(eCAL::TLayer::tlayer_all, eCAL::TLayer::smode_off);
+    publisher.SetLayerMode(eCAL::TLayer::tlayer_shm, eCAL::TLayer::smode_on);
+#if ECAL_VERSION_MAJOR > 5 || (ECAL_VERSION_MAJOR == 5 && ECAL_VERSION_MINOR >= 12)
+    publisher.ShmSetBufferCount(buffer_count);
+#endif
+    //wait for subscriber to connect
+    while (publisher.GetSubscriberCount() == 0 && eCAL::Ok())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::vector<char> message(message_size, 'x');
+    long long sent = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(duration_s);
+    while (std::chrono::steady_clock::now() < end)
+    {
+      publisher.Send(message.data(), message.size());
+      sent++;
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "buffers " << buffer_count << ", message size " << message_size << " B: "
+              << sent / seconds << " messages/s, " << sent * message_size / seconds / 1e6 << " MB/s" << std::endl;
+    return 0;
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode != "pub" && mode != "sub")
+  {
+    std::cerr << "usage: " << argv[0] << " sub [processing time us] | pub [buffer count] [message size] [duration s]" << std::endl;
+    return 1;
+  }
+
+  eCAL::Initialize(0, nullptr, "rmw_ecal_benchmark_shm_buffering");
+  int result = 0;
+  if (mode == "sub")
+  {
+    result = RunSubscriber(argc > 2 ? std::atoll(argv[2]) : 1000);
+  }
+  else
+  {
+    result = RunPublisher(argc > 2 ? std::atol(argv[2]) : 1,
+                          argc > 3 ? static_cast<size_t>(std::atoll(argv[3])) : 1024 * 1024,
+                          argc > 4 ? std::atoi(argv[4]) : 5);
+  }
+  eCAL::Finalize();
+  return result;
+}
@@ -0,0 +1,97 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+
+#include "internal/codec_cache.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  //Serializes every message as name of the factory which created the serializer.
+  class NamedSerializer : public Serializer
+  {
+    std::string name_;
+
+  public:
+    explicit NamedSerializer(std::string name) : name_(std::move(name)) {}
+
+    const std::string Serialize(const void *) override
+    {
+      return name_;
+    }
+
+    const std::string GetMessageStringDescriptor() const override
+    {
+      return "";
+    }
+  };
+
+  class NullDeserializer : public Deserializer
+  {
+  public:
+    void Deserialize(void *, const void *, size_t) override
+    {
+    }
+  };
+
+  template <char Name>
+  class NamedFactory : public SerializerFactory
+  {
+  public:
+    Serializer *CreateSerializer(const rosidl_message_type_support_t *) const override
+    {
+      return new NamedSerializer{std::string(1, Name)};
+    }
+
+    Deserializer *CreateDeserializer(const rosidl_message_type_support_t *) const override
+    {
+      return new NullDeserializer;
+    }
+  };
+
+  std::string Serialize(const SerializerFactory &factory, const rosidl_message_type_support_t *type_support)
+  {
+    std::string serialized;
+    CodecCache::Instance().WithSerializer(factory, type_support, [&](Serializer &serializer, SerializedSegments &) {
+      serialized = serializer.Serialize(nullptr);
+    });
+    return serialized;
+  }
+} // namespace
+
+TEST(CodecCache, EntriesArePerFactoryType)
+{
+  rosidl_message_type_support_t type_support{};
+  EXPECT_EQ("a", Serialize(NamedFactory<'a'>{}, &type_support));
+  EXPECT_EQ("b", Serialize(NamedFactory<'b'>{}, &type_support));
+  //temporary factory of same type finds the same entry
+  EXPECT_EQ("a", Serialize(NamedFactory<'a'>{}, &type_support));
+}
+
+TEST(CodecCache, DeserializationDoesNotWaitForSerialization)
+{
+  rosidl_message_type_support_t type_support{};
+  NamedFactory<'c'> factory;
+  CodecCache::Instance().WithSerializer(factory, &type_support, [&](Serializer &, SerializedSegments &) {
+    auto deserialized = std::async(std::launch::async, [&] {
+      CodecCache::Instance().WithDeserializer(factory, &type_support, [](Deserializer &) {});
+    });
+    EXPECT_EQ(std::future_status::ready, deserialized.wait_for(std::chrono::seconds(5)));
+  });
+}
@@ -0,0 +1,117 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "internal/ecal_config_loader.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  //empty value removes the variable
+  void SetEnvironment(const char *name, const char *value)
+  {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    if (value[0] == '\0')
+    {
+      unsetenv(name);
+    }
+    else
+    {
+      setenv(name, value, 1);
+    }
+#endif
+  }
+
+  void ClearEnvironment()
+  {
+    SetEnvironment("RMW_ECAL_INI_FILE", "");
+    SetEnvironment("RMW_ECAL_CONFIG_FILE", "");
+    SetEnvironment("RMW_ECAL_CONFIG", "");
+  }
+} // namespace
+
+TEST(EcalConfigLoader, ParseInline)
+{
+  EcalConfig config;
+  EcalConfigLoader::ParseInline(" publisher/use_shm = 2;;publisher/memfile_buf_count=3 ", config);
+  EXPECT_EQ("2", config.values["publisher/use_shm"]);
+  EXPECT_EQ("3", config.values["publisher/memfile_buf_count"]);
+
+  EXPECT_THROW(EcalConfigLoader::ParseInline("use_shm=2", config), std::runtime_error);
+  EXPECT_THROW(EcalConfigLoader::ParseInline("publisher/use_shm", config), std::runtime_error);
+}
+
+TEST(EcalConfigLoader, ParseYaml)
+{
+  std::istringstream yaml{
+      "---\n"
+      "ini_file: \"/etc/ecal/other.ini\"\n"
+      "publisher:\n"
+      "  use_shm: 2 # comment\n"
+      "topic_layers:\n"
+      "  \"/camera/*\": shm\n"
+      "  /diagnostics: udp\n"};
+  EcalConfig config;
+  EcalConfigLoader::ParseYaml(yaml, "test.yaml", config);
+  EXPECT_EQ("/etc/ecal/other.ini", config.ini_file);
+  EXPECT_EQ("2", config.values["publisher/use_shm"]);
+  ASSERT_EQ(2u, config.topic_layers.size());
+  EXPECT_EQ("/camera/*", config.topic_layers[0].first);
+  EXPECT_EQ("udp", config.topic_layers[1].second);
+
+  std::istringstream outside{"  use_shm: 2\n"};
+  EXPECT_THROW(EcalConfigLoader::ParseYaml(outside, "test.yaml", config), std::runtime_error);
+}
+
+TEST(EcalConfigLoader, InvalidEnvironmentIsIgnored)
+{
+  ClearEnvironment();
+  SetEnvironment("RMW_ECAL_INI_FILE", "/etc/ecal/other.ini");
+  SetEnvironment("RMW_ECAL_CONFIG_FILE", "/nonexistent/rmw_ecal.yaml");
+  //valid entry before invalid one must not be applied either
+  SetEnvironment("RMW_ECAL_CONFIG", "publisher/use_shm=2;invalid");
+
+  EcalConfig config;
+  ASSERT_NO_THROW(config = EcalConfigLoader::LoadFromEnvironment());
+  EXPECT_EQ("/etc/ecal/other.ini", config.ini_file);
+  EXPECT_TRUE(config.values.empty());
+
+  SetEnvironment("RMW_ECAL_CONFIG", "publisher/use_shm=2");
+  config = EcalConfigLoader::LoadFromEnvironment();
+  EXPECT_EQ("2", config.values["publisher/use_shm"]);
+  ClearEnvironment();
+}
+
+TEST(EcalConfigLoader, InitializeArguments)
+{
+  EcalConfig config;
+  config.ini_file = "other.ini";
+  config.Set("publisher/use_shm", 2);
+  config.Set("publisher/use_udp_mc", false);
+  auto args = EcalConfigLoader::ToInitializeArguments(config);
+  std::vector<std::string> expected{"rmw_ecal", "--ecal-ini-file", "other.ini",
+                                    "--set_config_key", "publisher/use_shm:2",
+                                    "--set_config_key", "publisher/use_udp_mc:false"};
+  EXPECT_EQ(expected, args);
+}
@@ -0,0 +1,198 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <ecal/ecal.h>
+
+#include "internal/liveliness.hpp"
+#include "internal/registration.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  const std::string topic_name{"rt/liveliness"};
+
+  struct Counts
+  {
+    int32_t alive;
+    int32_t not_alive;
+  };
+
+  Counts TakeCounts(LivelinessChangedEvent &event)
+  {
+    Counts counts{};
+    int32_t alive_change = 0;
+    int32_t not_alive_change = 0;
+    event.TakeStatus(counts.alive, counts.not_alive, alive_change, not_alive_change);
+    return counts;
+  }
+
+  //Registration of publisher in another process as monitoring reports it.
+  void AddRemoteWriter(pb::Monitoring &monitoring, const std::string &topic_id, int32_t rclock,
+                       const std::string &kind = "automatic", long long lease_ms = 0, const std::string &asserted = "")
+  {
+    auto topic = monitoring.add_topics();
+    topic->set_direction("publisher");
+    topic->set_hname("remote_host");
+    topic->set_pid(4242);
+    topic->set_tid(topic_id);
+    topic->set_tname(topic_name);
+    topic->set_rclock(rclock);
+    auto &attributes = *topic->mutable_attr();
+    attributes[liveliness_kind_attribute] = kind;
+    attributes[liveliness_lease_attribute] = std::to_string(lease_ms);
+    if (!asserted.empty())
+    {
+      attributes[liveliness_asserted_attribute] = asserted;
+    }
+  }
+} // namespace
+
+TEST(Liveliness, HeartbeatLeaseIsAtLeastTwoRefreshPeriods)
+{
+  const auto refresh_ms = Registration::RefreshPeriod().count();
+  EXPECT_EQ(0, LivelinessMonitor::ToHeartbeatLease(0));
+  EXPECT_EQ(2 * refresh_ms, LivelinessMonitor::ToHeartbeatLease(1));
+  EXPECT_EQ(10 * refresh_ms, LivelinessMonitor::ToHeartbeatLease(10 * refresh_ms));
+}
+
+TEST(Liveliness, EffectiveLeaseIsShorterFiniteLease)
+{
+  const auto refresh_ms = Registration::RefreshPeriod().count();
+  EXPECT_EQ(0, LivelinessMonitor::EffectiveLease(0, 0));
+  EXPECT_EQ(5 * refresh_ms, LivelinessMonitor::EffectiveLease(0, 5 * refresh_ms));
+  EXPECT_EQ(5 * refresh_ms, LivelinessMonitor::EffectiveLease(5 * refresh_ms, 0));
+  EXPECT_EQ(3 * refresh_ms, LivelinessMonitor::EffectiveLease(5 * refresh_ms, 3 * refresh_ms));
+  EXPECT_EQ(2 * refresh_ms, LivelinessMonitor::EffectiveLease(1, 5 * refresh_ms));
+}
+
+TEST(Liveliness, RemoteWritersAreJudgedByHeartbeat)
+{
+  const auto lease_ms = LivelinessMonitor::ToHeartbeatLease(1);
+  LivelinessMonitor monitor{false};
+  LivelinessChangedEvent changed_event;
+  auto reader = monitor.AddReader(topic_name, lease_ms, false, changed_event);
+
+  pb::Monitoring first;
+  AddRemoteWriter(first, "alive", 1);
+  AddRemoteWriter(first, "stale", 1);
+  AddRemoteWriter(first, "unasserted", 1, liveliness_manual_by_topic, lease_ms, "0");
+  monitor.Scan(first, 0);
+  auto counts = TakeCounts(changed_event);
+  EXPECT_EQ(2, counts.alive);
+  EXPECT_EQ(1, counts.not_alive);
+
+  //only alive writer keeps registering, stale one's rclock doesn't change beyond lease
+  pb::Monitoring second;
+  AddRemoteWriter(second, "alive", 2);
+  AddRemoteWriter(second, "stale", 1);
+  AddRemoteWriter(second, "unasserted", 2, liveliness_manual_by_topic, lease_ms, "0");
+  monitor.Scan(second, lease_ms + 1);
+  counts = TakeCounts(changed_event);
+  EXPECT_EQ(1, counts.alive);
+  EXPECT_EQ(2, counts.not_alive);
+
+  //unregistered writers are neither alive nor not alive
+  pb::Monitoring third;
+  AddRemoteWriter(third, "alive", 3);
+  monitor.Scan(third, lease_ms + 2);
+  counts = TakeCounts(changed_event);
+  EXPECT_EQ(1, counts.alive);
+  EXPECT_EQ(0, counts.not_alive);
+
+  monitor.Scan(pb::Monitoring{}, lease_ms + 3);
+  counts = TakeCounts(changed_event);
+  EXPECT_EQ(0, counts.alive);
+  EXPECT_EQ(0, counts.not_alive);
+
+  monitor.RemoveReader(reader);
+}
+
+TEST(Liveliness, WritersOfThisProcessAreSkippedInMonitoring)
+{
+  LivelinessMonitor monitor{false};
+  LivelinessChangedEvent changed_event;
+  auto reader = monitor.AddReader(topic_name, 0, false, changed_event);
+
+  pb::Monitoring monitoring;
+  auto topic = monitoring.add_topics();
+  topic->set_direction("publisher");
+  topic->set_hname(eCAL::Process::GetHostName());
+  topic->set_pid(eCAL::Process::GetProcessID());
+  topic->set_tname(topic_name);
+  monitor.Scan(monitoring, 0);
+  auto counts = TakeCounts(changed_event);
+  EXPECT_EQ(0, counts.alive);
+  EXPECT_EQ(0, counts.not_alive);
+
+  monitor.RemoveReader(reader);
+}
+
+TEST(Liveliness, ManualWriterLosesAndRegainsLiveliness)
+{
+  const long long lease_ms = 100;
+  LivelinessMonitor monitor{false};
+  eCAL::CPublisher publisher;
+  Event lost_event;
+  auto writer = monitor.AddWriter(topic_name, publisher, true, lease_ms, lost_event);
+  LivelinessChangedEvent changed_event;
+  auto reader = monitor.AddReader(topic_name, 0, false, changed_event);
+  writer->last_assertion_ms.store(0);
+
+  monitor.Scan(pb::Monitoring{}, lease_ms);
+  EXPECT_TRUE(writer->alive);
+  EXPECT_FALSE(lost_event.Triggered());
+  auto counts = TakeCounts(changed_event);
+  EXPECT_EQ(1, counts.alive);
+  EXPECT_EQ(0, counts.not_alive);
+
+  //no assertion within lease
+  monitor.Scan(pb::Monitoring{}, lease_ms + 1);
+  EXPECT_FALSE(writer->alive);
+  EXPECT_TRUE(lost_event.Triggered());
+  counts = TakeCounts(changed_event);
+  EXPECT_EQ(0, counts.alive);
+  EXPECT_EQ(1, counts.not_alive);
+
+  //asserting (publishing) makes it alive again
+  writer->last_assertion_ms.store(lease_ms + 2);
+  monitor.Scan(pb::Monitoring{}, lease_ms + 3);
+  EXPECT_TRUE(writer->alive);
+  counts = TakeCounts(changed_event);
+  EXPECT_EQ(1, counts.alive);
+  EXPECT_EQ(0, counts.not_alive);
+
+  monitor.RemoveReader(reader);
+  monitor.RemoveWriter(writer);
+}
+
+TEST(Liveliness, ReaderIgnoringLocalPublicationsDoesNotCountLocalWriters)
+{
+  LivelinessMonitor monitor{false};
+  eCAL::CPublisher publisher;
+  Event lost_event;
+  auto writer = monitor.AddWriter(topic_name, publisher, false, 0, lost_event);
+  LivelinessChangedEvent changed_event;
+  auto reader = monitor.AddReader(topic_name, 0, true, changed_event);
+
+  monitor.Scan(pb::Monitoring{}, 0);
+  EXPECT_FALSE(changed_event.Triggered());
+
+  monitor.RemoveReader(reader);
+  monitor.RemoveWriter(writer);
+}
@@ -0,0 +1,79 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <rmw/qos_profiles.h>
+
+#include "internal/qos.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  rmw_qos_profile_t Profile(rmw_qos_history_policy_t history, size_t depth,
+                            rmw_qos_reliability_policy_t reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE)
+  {
+    auto qos = rmw_qos_profile_default;
+    qos.history = history;
+    qos.depth = depth;
+    qos.reliability = reliability;
+    return qos;
+  }
+} // namespace
+
+TEST(Qos, KeepLastDepthIsShmBufferCount)
+{
+  auto qos = Profile(RMW_QOS_POLICY_HISTORY_KEEP_LAST, 3);
+  EXPECT_EQ(3, ToShmBufferCount(&qos));
+  EXPECT_EQ(3, CreatePublisherQOS(&qos).shm_buffer_count);
+}
+
+TEST(Qos, DefaultProfileDepthIsMapped)
+{
+  //depth 10 of default profile is capped like any other
+  EXPECT_EQ(max_shm_buffer_count, ToShmBufferCount(&rmw_qos_profile_default));
+  auto qos = Profile(RMW_QOS_POLICY_HISTORY_KEEP_LAST, 1000);
+  EXPECT_EQ(max_shm_buffer_count, ToShmBufferCount(&qos));
+}
+
+TEST(Qos, DepthZeroUsesSingleBuffer)
+{
+  auto qos = Profile(RMW_QOS_POLICY_HISTORY_KEEP_LAST, 0);
+  EXPECT_EQ(1, ToShmBufferCount(&qos));
+}
+
+TEST(Qos, KeepAllUsesMaximumBufferCount)
+{
+  auto qos = Profile(RMW_QOS_POLICY_HISTORY_KEEP_ALL, 1);
+  EXPECT_EQ(max_shm_buffer_count, ToShmBufferCount(&qos));
+}
+
+TEST(Qos, SystemDefaultHistoryKeepsECalConfiguration)
+{
+  auto qos = Profile(RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT, 5);
+  EXPECT_EQ(0, ToShmBufferCount(&qos));
+  EXPECT_EQ(0, ToShmAcknowledgeTimeout(&qos));
+}
+
+TEST(Qos, OnlyReliableKeepAllWaitsForAcknowledgement)
+{
+  auto reliable_keep_all = Profile(RMW_QOS_POLICY_HISTORY_KEEP_ALL, 1);
+  EXPECT_EQ(keep_all_shm_acknowledge_timeout_ms, ToShmAcknowledgeTimeout(&reliable_keep_all));
+  EXPECT_EQ(keep_all_shm_acknowledge_timeout_ms, CreatePublisherQOS(&reliable_keep_all).shm_acknowledge_timeout_ms);
+
+  auto best_effort_keep_all = Profile(RMW_QOS_POLICY_HISTORY_KEEP_ALL, 1, RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT);
+  EXPECT_EQ(0, ToShmAcknowledgeTimeout(&best_effort_keep_all));
+  auto reliable_keep_last = Profile(RMW_QOS_POLICY_HISTORY_KEEP_LAST, 8);
+  EXPECT_EQ(0, ToShmAcknowledgeTimeout(&reliable_keep_last));
+}
@@ -0,0 +1,125 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rmw_ecal_shared_cpp/serialized_segments.hpp"
+
+#include "internal/sample_history.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  void Store(SampleHistory &history, const std::string &message, uint64_t sequence_number)
+  {
+    history.Store(message.data(), message.size(), static_cast<long long>(sequence_number) * 1000, sequence_number);
+  }
+
+  std::vector<std::string> Messages(const SampleHistory &history)
+  {
+    std::vector<std::string> messages;
+    history.ForEach([&messages](const SampleHistory::Sample &sample) {
+      messages.emplace_back(sample.data.begin(), sample.data.end());
+    });
+    return messages;
+  }
+
+  std::vector<uint64_t> SequenceNumbers(const SampleHistory &history)
+  {
+    std::vector<uint64_t> sequence_numbers;
+    history.ForEach([&sequence_numbers](const SampleHistory::Sample &sample) {
+      EXPECT_EQ(static_cast<long long>(sample.sequence_number) * 1000, sample.send_timestamp);
+      sequence_numbers.push_back(sample.sequence_number);
+    });
+    return sequence_numbers;
+  }
+} // namespace
+
+TEST(SampleHistory, EmptyHistory)
+{
+  SampleHistory history{3};
+  EXPECT_TRUE(Messages(history).empty());
+}
+
+TEST(SampleHistory, KeepsMessagesUntilFull)
+{
+  SampleHistory history{3};
+  Store(history, "a", 1);
+  Store(history, "b", 2);
+
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), Messages(history));
+  EXPECT_EQ((std::vector<uint64_t>{1, 2}), SequenceNumbers(history));
+}
+
+TEST(SampleHistory, OverwritesOldestMessages)
+{
+  SampleHistory history{3};
+  for (uint64_t i = 1; i <= 7; i++)
+  {
+    Store(history, std::string(i, 'x'), i);
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"xxxxx", "xxxxxx", "xxxxxxx"}), Messages(history));
+  EXPECT_EQ((std::vector<uint64_t>{5, 6, 7}), SequenceNumbers(history));
+}
+
+TEST(SampleHistory, ZeroDepthKeepsLastMessage)
+{
+  SampleHistory history{0};
+  Store(history, "a", 1);
+  Store(history, "b", 2);
+
+  EXPECT_EQ((std::vector<std::string>{"b"}), Messages(history));
+}
+
+TEST(SampleHistory, StoresSegments)
+{
+  const std::string large(64, 'l');
+  SerializedSegments segments{16};
+  segments.Append("head", 4);
+  segments.AppendReferenced(large.data(), large.size());
+  segments.Append("tail", 4);
+  ASSERT_FALSE(segments.IsContiguous());
+
+  SampleHistory history{2};
+  Store(history, "a much longer message than the segmented one", 1);
+  Store(history, "b", 2);
+  //overwrites first sample, whose buffer is reused
+  history.Store(segments, 3000, 3);
+
+  EXPECT_EQ((std::vector<std::string>{"b", "head" + large + "tail"}), Messages(history));
+  EXPECT_EQ((std::vector<uint64_t>{2, 3}), SequenceNumbers(history));
+}
+
+TEST(SampleHistory, CopyIsIndependentOfHistory)
+{
+  SampleHistory history{2};
+  Store(history, "a", 1);
+  Store(history, "b", 2);
+  Store(history, "c", 3);
+
+  auto samples = history.Copy();
+  //messages stored after copy must not change it
+  Store(history, "d", 4);
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ("b", std::string(samples[0].data.begin(), samples[0].data.end()));
+  EXPECT_EQ(2u, samples[0].sequence_number);
+  EXPECT_EQ("c", std::string(samples[1].data.begin(), samples[1].data.end()));
+  EXPECT_EQ(3u, samples[1].sequence_number);
+}
@@ -0,0 +1,509 @@
+// Copyright 2020 Continental AG
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ecal/ecal.h>
+#include <ecal/ecal_time.h>
+
+#include <rmw/qos_profiles.h>
+
+#include "rmw_ecal_shared_cpp/message_typesupport.hpp"
+
+#include "internal/qos.hpp"
+#include "internal/publisher.hpp"
+#include "internal/subscriber.hpp"
+
+using namespace eCAL::rmw;
+
+namespace
+{
+  //Messages are plain std::string, serialized as their characters.
+  class StringTypeSupport : public MessageTypeSupport
+  {
+  public:
+    const std::string GetMessageNamespace() const override
+    {
+      return "test_msgs::msg";
+    }
+
+    const std::string GetMessageSimpleName() const override
+    {
+      return "String";
+    }
+
+    const std::string GetMessageName() const override
+    {
+      return "test_msgs/msg/String";
+    }
+
+    size_t GetTypeSize() const override
+    {
+      return sizeof(std::string);
+    }
+
+    const std::string Serialize(const void *data) override
+    {
+      return *static_cast<const std::string *>(data);
+    }
+
+    void Deserialize(void *message, const void *serialized_data, size_t size) override
+    {
+      static_cast<std::string *>(message)->assign(static_cast<const char *>(serialized_data), size);
+    }
+
+    std::string GetTypeDescriptor() const override
+    {
+      return "";
+    }
+  };
+
+  //publishers of locally delivered messages are mostly not created, only their ids are used
+  constexpr long long publisher_a = 1;
+  constexpr long long publisher_b = 2;
+  //stands for publisher of other process which announced lifespan of 100 ms
+  constexpr long long publisher_with_lifespan = 3;
+  constexpr long long lifespan_us = 100000;
+
+  rmw_qos_profile_t KeepLast(size_t depth)
+  {
+    auto qos = rmw_qos_profile_default;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = depth;
+    return qos;
+  }
+
+  rmw_qos_profile_t TransientLocal(size_t depth)
+  {
+    auto qos = KeepLast(depth);
+    qos.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+    return qos;
+  }
+
+  std::unique_ptr<Subscriber> CreateSubscriber(const std::string &topic_name, const rmw_qos_profile_t &qos)
+  {
+    return std::unique_ptr<Subscriber>(new Subscriber{topic_name, "node", "/", new StringTypeSupport, CreateSubscriberQOS(&qos)});
+  }
+
+  std::unique_ptr<Publisher> CreatePublisher(const std::string &topic_name, const rmw_qos_profile_t &qos)
+  {
+    return std::unique_ptr<Publisher>(new Publisher{topic_name, "node", "/", new StringTypeSupport, CreatePublisherQOS(&qos)});
+  }
+
+  void Receive(Subscriber &subscriber, const std::string &message, long long publisher_id, uint64_t sequence_number,
+               long long send_timestamp = eCAL::Time::GetMicroSeconds())
+  {
+    subscriber.ReceiveLocalData(message.data(), message.size(), send_timestamp, publisher_id, sequence_number);
+  }
+
+  std::vector<std::string> TakeAll(Subscriber &subscriber)
+  {
+    std::vector<std::string> messages;
+    std::string message;
+    while (subscriber.TakeLatestData(&message))
+    {
+      messages.push_back(message);
+    }
+    return messages;
+  }
+
+  uint64_t TakeEventCount(Event &event)
+  {
+    uint64_t total_count = 0;
+    uint64_t total_count_change = 0;
+    event.Take(total_count, total_count_change);
+    return total_count_change;
+  }
+
+  void Publish(Publisher &publisher, const std::string &message)
+  {
+    publisher.PublishRaw(message.data(), message.size());
+  }
+
+  bool WaitForEvent(const Event &event, std::chrono::milliseconds timeout)
+  {
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while (!event.Triggered() && std::chrono::steady_clock::now() < end)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return event.Triggered();
+  }
+} // namespace
+
+class SubscriberTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    eCAL::Initialize(0, nullptr, "test_subscriber");
+    Lifespans::Instance().AddLocal(publisher_with_lifespan, lifespan_us);
+  }
+
+  static void TearDownTestCase()
+  {
+    Lifespans::Instance().RemoveLocal(publisher_with_lifespan);
+    eCAL::Finalize();
+  }
+};
+
+TEST_F(SubscriberTest, ConsecutiveMessagesAreNotLost)
+{
+  auto subscriber = CreateSubscriber("consecutive", KeepLast(10));
+  Receive(*subscriber, "a", publisher_a, 1);
+  Receive(*subscriber, "b", publisher_a, 2);
+  Receive(*subscriber, "c", publisher_a, 3);
+
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+  EXPECT_FALSE(subscriber->GetMessageLostEventListener().Triggered());
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, GapsAreCountedAsLost)
+{
+  auto subscriber = CreateSubscriber("gaps", KeepLast(10));
+  Receive(*subscriber, "a", publisher_a, 1);
+  Receive(*subscriber, "b", publisher_a, 4);
+  Receive(*subscriber, "c", publisher_a, 5);
+  Receive(*subscriber, "d", publisher_a, 10);
+
+  EXPECT_EQ(6u, subscriber->CountLostMessages());
+  EXPECT_EQ(6u, TakeEventCount(subscriber->GetMessageLostEventListener()));
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c", "d"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, FirstMessageIsNotGap)
+{
+  //subscriber joining late doesn't count messages sent before it existed
+  auto subscriber = CreateSubscriber("first_message", KeepLast(10));
+  Receive(*subscriber, "a", publisher_a, 100);
+
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, GapsAreTrackedPerPublisher)
+{
+  auto subscriber = CreateSubscriber("per_publisher", KeepLast(10));
+  Receive(*subscriber, "a1", publisher_a, 1);
+  Receive(*subscriber, "b1", publisher_b, 7);
+  Receive(*subscriber, "a2", publisher_a, 2);
+  Receive(*subscriber, "b2", publisher_b, 9);
+
+  EXPECT_EQ(1u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, RecreatedPublisherIsNotGap)
+{
+  auto subscriber = CreateSubscriber("recreated", KeepLast(10));
+  Receive(*subscriber, "a", publisher_a, 5);
+  Receive(*subscriber, "b", publisher_a, 1);
+  Receive(*subscriber, "c", publisher_a, 2);
+
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, KeepLastOverflowIsCountedAsLost)
+{
+  auto subscriber = CreateSubscriber("overflow", KeepLast(2));
+  for (uint64_t i = 1; i <= 5; i++)
+  {
+    Receive(*subscriber, std::to_string(i), publisher_a, i);
+  }
+
+  EXPECT_EQ(3u, subscriber->CountLostMessages());
+  EXPECT_EQ(3u, TakeEventCount(subscriber->GetMessageLostEventListener()));
+  EXPECT_EQ((std::vector<std::string>{"4", "5"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, KeepAllDoesNotDrop)
+{
+  auto qos = rmw_qos_profile_default;
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_ALL;
+  qos.depth = 1;
+  auto subscriber = CreateSubscriber("keep_all", qos);
+  for (uint64_t i = 1; i <= 5; i++)
+  {
+    Receive(*subscriber, std::to_string(i), publisher_a, i);
+  }
+
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+  EXPECT_EQ(5u, TakeAll(*subscriber).size());
+}
+
+TEST_F(SubscriberTest, FailedSerializedTakeKeepsMessage)
+{
+  auto subscriber = CreateSubscriber("failed_take", KeepLast(10));
+  Receive(*subscriber, "a", publisher_a, 1);
+  Receive(*subscriber, "b", publisher_a, 2);
+
+  Subscriber::MessageInfo info;
+  EXPECT_FALSE(subscriber->TakeLatestSerializedData([](const char *, size_t) { return false; }, info));
+  std::string taken;
+  EXPECT_TRUE(subscriber->TakeLatestSerializedData([&](const char *data, size_t size) {
+    taken.assign(data, size);
+    return true;
+  }, info));
+  EXPECT_EQ("a", taken);
+  EXPECT_EQ(1u, info.publication_sequence_number);
+  EXPECT_EQ((std::vector<std::string>{"b"}), TakeAll(*subscriber));
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, ExpiredMessagesAreDiscarded)
+{
+  auto subscriber = CreateSubscriber("lifespan", KeepLast(10));
+  auto now = eCAL::Time::GetMicroSeconds();
+  Receive(*subscriber, "expired", publisher_with_lifespan, 1, now - 1000000);
+  Receive(*subscriber, "fresh", publisher_with_lifespan, 2, now);
+
+  EXPECT_EQ((std::vector<std::string>{"fresh"}), TakeAll(*subscriber));
+  //expired messages are neither lost nor taken
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, OnlyExpiredMessagesAreNotTaken)
+{
+  auto subscriber = CreateSubscriber("lifespan_expired", KeepLast(10));
+  Receive(*subscriber, "expired", publisher_with_lifespan, 1, eCAL::Time::GetMicroSeconds() - 1000000);
+
+  std::string message;
+  EXPECT_FALSE(subscriber->TakeLatestData(&message));
+  EXPECT_FALSE(subscriber->HasData());
+}
+
+TEST_F(SubscriberTest, LifespanIsTrackedPerPublisher)
+{
+  auto subscriber = CreateSubscriber("lifespan_per_publisher", KeepLast(10));
+  auto old = eCAL::Time::GetMicroSeconds() - 1000000;
+  Receive(*subscriber, "a", publisher_a, 1, old);
+  Receive(*subscriber, "expired", publisher_with_lifespan, 1, old);
+  Receive(*subscriber, "b", publisher_a, 2, old);
+
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, SubscriberLifespanIsIgnored)
+{
+  //lifespan is publisher policy only
+  auto qos = KeepLast(10);
+  qos.lifespan = rmw_time_t{0, 100000000};
+  auto subscriber = CreateSubscriber("lifespan_subscriber", qos);
+  Receive(*subscriber, "old", publisher_a, 1, 0);
+
+  EXPECT_EQ((std::vector<std::string>{"old"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, PublisherLifespanExpiresMessages)
+{
+  auto subscriber = CreateSubscriber("lifespan_publisher", KeepLast(10));
+  auto qos = KeepLast(10);
+  qos.lifespan = rmw_time_t{0, 50000000};
+  auto publisher = CreatePublisher("lifespan_publisher", qos);
+  Publish(*publisher, "expired");
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Publish(*publisher, "fresh");
+
+  EXPECT_EQ((std::vector<std::string>{"fresh"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, RemoteLifespansAreReadFromRegistration)
+{
+  pb::Monitoring monitoring;
+  auto add_publisher = [&](const std::string &host_name, int process_id, long long publisher_id) {
+    auto topic = monitoring.add_topics();
+    topic->set_direction("publisher");
+    topic->set_hname(host_name);
+    topic->set_pid(process_id);
+    (*topic->mutable_attr())[publisher_id_attribute] = std::to_string(publisher_id);
+    (*topic->mutable_attr())[lifespan_attribute] = "250000";
+  };
+  add_publisher("remote", 1, 10);
+  add_publisher("local", 2, 11);
+  //native eCAL publisher
+  monitoring.add_topics()->set_direction("publisher");
+
+  auto lifespans = ReadRemoteLifespans(monitoring, "local", 2);
+  ASSERT_EQ(1u, lifespans.size());
+  EXPECT_EQ(250000, lifespans[10]);
+}
+
+TEST_F(SubscriberTest, DefaultLifespanKeepsMessages)
+{
+  auto subscriber = CreateSubscriber("lifespan_default", KeepLast(10));
+  auto publisher = CreatePublisher("lifespan_default", KeepLast(10));
+  Publish(*publisher, "a");
+  Receive(*subscriber, "old", publisher_a, 1, 0);
+
+  EXPECT_EQ((std::vector<std::string>{"a", "old"}), TakeAll(*subscriber));
+}
+
+#ifdef RMW_DURATION_INFINITE
+TEST_F(SubscriberTest, InfiniteLifespanKeepsMessages)
+{
+  auto subscriber = CreateSubscriber("lifespan_infinite", KeepLast(10));
+  auto qos = KeepLast(10);
+  qos.lifespan = RMW_DURATION_INFINITE;
+  auto publisher = CreatePublisher("lifespan_infinite", qos);
+  Publish(*publisher, "a");
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  EXPECT_EQ((std::vector<std::string>{"a"}), TakeAll(*subscriber));
+}
+#endif
+
+TEST_F(SubscriberTest, DeadlineIsMissedWithoutMessages)
+{
+  auto qos = KeepLast(10);
+  qos.deadline = rmw_time_t{0, 20000000};
+  auto subscriber = CreateSubscriber("deadline_missed", qos);
+
+  EXPECT_TRUE(WaitForEvent(subscriber->GetDeadlineMissedEventListener(), std::chrono::seconds(2)));
+}
+
+TEST_F(SubscriberTest, DeadlineMissesAreCountedPerPeriod)
+{
+  auto qos = KeepLast(10);
+  qos.deadline = rmw_time_t{0, 20000000};
+  auto subscriber = CreateSubscriber("deadline_periods", qos);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  //timer thread may lag behind, but it reports every elapsed period once
+  auto misses = TakeEventCount(subscriber->GetDeadlineMissedEventListener());
+  EXPECT_GE(misses, 2u);
+  EXPECT_LE(misses, 15u);
+}
+
+TEST_F(SubscriberTest, MessagesRearmDeadline)
+{
+  auto qos = KeepLast(10);
+  qos.deadline = rmw_time_t{0, 200000000};
+  auto subscriber = CreateSubscriber("deadline_met", qos);
+  for (uint64_t i = 1; i <= 60; i++)
+  {
+    Receive(*subscriber, "a", publisher_a, i);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_FALSE(subscriber->GetDeadlineMissedEventListener().Triggered());
+
+  EXPECT_TRUE(WaitForEvent(subscriber->GetDeadlineMissedEventListener(), std::chrono::seconds(2)));
+}
+
+TEST_F(SubscriberTest, PublishingRearmsOfferedDeadline)
+{
+  auto qos = KeepLast(10);
+  qos.deadline = rmw_time_t{0, 200000000};
+  auto publisher = CreatePublisher("offered_deadline", qos);
+  for (int i = 0; i < 60; i++)
+  {
+    Publish(*publisher, "a");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_FALSE(publisher->GetDeadlineMissedEventListener().Triggered());
+
+  EXPECT_TRUE(WaitForEvent(publisher->GetDeadlineMissedEventListener(), std::chrono::seconds(2)));
+}
+
+TEST_F(SubscriberTest, DefaultDeadlineIsNeverMissed)
+{
+  auto subscriber = CreateSubscriber("deadline_default", KeepLast(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  EXPECT_FALSE(subscriber->GetDeadlineMissedEventListener().Triggered());
+}
+
+//Remote transient local publishers replay history over eCAL, in-process ones hand it over
+//directly when subscriber is created, so history is received without network delay.
+TEST_F(SubscriberTest, LateJoinerReceivesHistory)
+{
+  auto publisher = CreatePublisher("late_joiner", TransientLocal(3));
+  for (int i = 1; i <= 5; i++)
+  {
+    Publish(*publisher, std::to_string(i));
+  }
+
+  auto subscriber = CreateSubscriber("late_joiner", TransientLocal(10));
+  EXPECT_EQ((std::vector<std::string>{"3", "4", "5"}), TakeAll(*subscriber));
+
+  //live messages continue after history without gap
+  Publish(*publisher, "6");
+  EXPECT_EQ((std::vector<std::string>{"6"}), TakeAll(*subscriber));
+  EXPECT_EQ(0u, subscriber->CountLostMessages());
+}
+
+TEST_F(SubscriberTest, VolatileSubscriberDoesNotReceiveHistory)
+{
+  auto publisher = CreatePublisher("volatile_joiner", TransientLocal(3));
+  Publish(*publisher, "1");
+
+  auto subscriber = CreateSubscriber("volatile_joiner", KeepLast(10));
+  EXPECT_FALSE(subscriber->HasData());
+
+  Publish(*publisher, "2");
+  EXPECT_EQ((std::vector<std::string>{"2"}), TakeAll(*subscriber));
+}
+
+TEST_F(SubscriberTest, VolatilePublisherKeepsNoHistory)
+{
+  auto publisher = CreatePublisher("volatile_publisher", KeepLast(3));
+  Publish(*publisher, "1");
+
+  auto subscriber = CreateSubscriber("volatile_publisher", TransientLocal(10));
+  EXPECT_FALSE(subscriber->HasData());
+}
+
+TEST_F(SubscriberTest, HistoryOfEveryPublisherIsReceived)
+{
+  auto first_publisher = CreatePublisher("two_histories", TransientLocal(2));
+  auto second_publisher = CreatePublisher("two_histories", TransientLocal(2));
+  Publish(*first_publisher, "a1");
+  Publish(*second_publisher, "b1");
+  Publish(*first_publisher, "a2");
+
+  auto subscriber = CreateSubscriber("two_histories", TransientLocal(10));
+  auto messages = TakeAll(*subscriber);
+  std::sort(messages.begin(), messages.end());
+  EXPECT_EQ((std::vector<std::string>{"a1", "a2", "b1"}), messages);
+}
+
+TEST_F(SubscriberTest, HistoryIsGoneWithPublisher)
+{
+  auto publisher = CreatePublisher("destroyed_publisher", TransientLocal(3));
+  Publish(*publisher, "1");
+  publisher.reset();
+
+  auto subscriber = CreateSubscriber("destroyed_publisher", TransientLocal(10));
+  EXPECT_FALSE(subscriber->HasData());
+}
+
+TEST_F(SubscriberTest, KeepAllPublisherKeepsWholeHistory)
+{
+  auto qos = TransientLocal(1);
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_ALL;
+  auto publisher = CreatePublisher("keep_all_history", qos);
+  for (int i = 1; i <= 20; i++)
+  {
+    Publish(*publisher, std::to_string(i));
+  }
+
+  auto subscriber = CreateSubscriber("keep_all_history", TransientLocal(100));
+  EXPECT_EQ(20u, TakeAll(*subscriber).size());
+}